@@ -0,0 +1,65 @@
+#!/usr/bin/env bash
+# Runs a dedicated server plus N null-RHI bot clients over loopback with -InventorySoak and waits for them
+# to exit. The server writes its report to <Project>/Saved/Soak/InventorySoak-<time>.json.
+#
+#   SERVER_CMD="/path/to/CowFieldCleanupServer" \
+#   CLIENT_CMD="/path/to/UnrealEditor /path/to/CowFieldCleanup.uproject -game" \
+#   Scripts/RunInventorySoak.sh -c 6 -d 300 -m /Game/Maps/CowField
+set -euo pipefail
+
+clients=6
+duration=300
+warmup=10
+map=""
+port=7777
+log_dir="${LOG_DIR:-$(pwd)/SoakLogs}"
+
+usage()
+{
+	echo "usage: $0 [-c clients] [-d seconds] [-w warmup_seconds] [-m map] [-p port]" >&2
+	exit 1
+}
+
+while getopts "c:d:w:m:p:" option; do
+	case "$option" in
+		c) clients="$OPTARG" ;;
+		d) duration="$OPTARG" ;;
+		w) warmup="$OPTARG" ;;
+		m) map="$OPTARG" ;;
+		p) port="$OPTARG" ;;
+		*) usage ;;
+	esac
+done
+
+if [[ -z "${SERVER_CMD:-}" || -z "${CLIENT_CMD:-}" ]]; then
+	echo "SERVER_CMD and CLIENT_CMD must point at the server target and a game client." >&2
+	usage
+fi
+
+mkdir -p "$log_dir"
+common_args=(-InventorySoak "-InventorySoakWarmup=$warmup" -unattended -nosound -log)
+
+# shellcheck disable=SC2086
+$SERVER_CMD $map "-Port=$port" "-InventorySoakDuration=$duration" "${common_args[@]}" "-abslog=$log_dir/Server.log" &
+server_pid=$!
+sleep 5
+
+# Clients run longer than the server so the server, which reports and exits first, sets the end of the run.
+client_pids=()
+for ((client = 0; client < clients; ++client)); do
+	# shellcheck disable=SC2086
+	$CLIENT_CMD "127.0.0.1:$port" -nullrhi -windowed -ResX=320 -ResY=240 "-InventorySoakDuration=$((duration + 30))" \
+		"${common_args[@]}" "-abslog=$log_dir/Client$client.log" &
+	client_pids+=("$!")
+done
+
+trap 'kill "$server_pid" "${client_pids[@]}" 2>/dev/null || true' INT TERM
+
+server_status=0
+wait "$server_pid" || server_status=$?
+for pid in "${client_pids[@]}"; do
+	wait "$pid" || true
+done
+
+grep "Inventory soak" "$log_dir/Server.log" || true
+exit "$server_status"
@@ -0,0 +1,282 @@
+#include "AI/DroppedToolQuerySubsystem.h"
+
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+#include "Inventory/DroppedToolRegistrySubsystem.h"
+#include "Inventory/InventoryStats.h"
+#include "Math/VectorRegister.h"
+
+DECLARE_CYCLE_STAT(TEXT("DroppedToolQueryPass"), STAT_InventoryDroppedToolQueryPass, STATGROUP_Inventory);
+
+static TAutoConsoleVariable<float> CVarCowFieldCleanupDroppedToolQueryBudgetMs(
+	TEXT("CowFieldCleanup.AI.DroppedToolQueryBudgetMs"),
+	0.25f,
+	TEXT("Game thread time per frame spent evaluating AI dropped tool queries. At least one request is evaluated every frame."));
+
+static TAutoConsoleVariable<float> CVarCowFieldCleanupDroppedToolQueryLifetime(
+	TEXT("CowFieldCleanup.AI.DroppedToolQueryLifetime"),
+	5.0f,
+	TEXT("Seconds a dropped tool query stays registered after its querier last requested it."));
+
+namespace DroppedToolQuery
+{
+	// Far enough that padding lanes never pass the radius test, small enough that squaring stays finite.
+	constexpr float PaddingCoordinate = 1.0e18f;
+	constexpr int32 LaneCount = 4;
+}
+
+bool UDroppedToolQuerySubsystem::ShouldCreateSubsystem(UObject* Outer) const
+{
+	const UWorld* World = Cast<UWorld>(Outer);
+	return World && World->IsGameWorld() && World->GetNetMode() != NM_Client && Super::ShouldCreateSubsystem(Outer);
+}
+
+void UDroppedToolQuerySubsystem::Deinitialize()
+{
+	Requests.Reset();
+	RequestIndexByQuerier.Reset();
+	SnapshotX.Reset();
+	SnapshotY.Reset();
+	SnapshotZ.Reset();
+	SnapshotToolIds.Reset();
+	SnapshotLocations.Reset();
+	CandidateHeap.Reset();
+	bHasSnapshot = false;
+
+	Super::Deinitialize();
+}
+
+void UDroppedToolQuerySubsystem::Tick(float DeltaTime)
+{
+	INVENTORY_SCOPE_CYCLE_COUNTER(STAT_InventoryDroppedToolQueryPass);
+
+	Super::Tick(DeltaTime);
+
+	const UWorld* World = GetWorld();
+	const double CurrentTimeSeconds = World->GetTimeSeconds();
+	const double LifetimeSeconds = CVarCowFieldCleanupDroppedToolQueryLifetime.GetValueOnGameThread();
+
+	for (int32 RequestIndex = Requests.Num() - 1; RequestIndex >= 0; --RequestIndex)
+	{
+		const FQueryRequest& Request = Requests[RequestIndex];
+		if (!Request.Querier.IsValid() || (CurrentTimeSeconds - Request.LastRequestedSeconds) > LifetimeSeconds)
+		{
+			RemoveRequestAt(RequestIndex);
+		}
+	}
+
+	if (Requests.IsEmpty())
+	{
+		return;
+	}
+
+	if (const UDroppedToolRegistrySubsystem* ToolRegistry = World->GetSubsystem<UDroppedToolRegistrySubsystem>())
+	{
+		RefreshSnapshot(*ToolRegistry);
+	}
+
+	// Round-robin from where the previous frame stopped so every request is refreshed at the same rate under load.
+	const double BudgetSeconds = FMath::Max(CVarCowFieldCleanupDroppedToolQueryBudgetMs.GetValueOnGameThread(), 0.0f) / 1000.0;
+	const double StartSeconds = FPlatformTime::Seconds();
+	int32 NumEvaluated = 0;
+	while (NumEvaluated < Requests.Num())
+	{
+		if (NextRequestIndex >= Requests.Num())
+		{
+			NextRequestIndex = 0;
+		}
+
+		EvaluateRequest(Requests[NextRequestIndex]);
+		++NextRequestIndex;
+		++NumEvaluated;
+
+		if ((FPlatformTime::Seconds() - StartSeconds) >= BudgetSeconds)
+		{
+			break;
+		}
+	}
+}
+
+bool UDroppedToolQuerySubsystem::IsTickable() const
+{
+	return !Requests.IsEmpty();
+}
+
+TStatId UDroppedToolQuerySubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UDroppedToolQuerySubsystem, STATGROUP_Inventory);
+}
+
+void UDroppedToolQuerySubsystem::RequestNearestTools(const UObject* Querier, const FVector& Center, float Radius, int32 MaxResults)
+{
+	if (!Querier || Radius <= 0.0f || MaxResults <= 0)
+	{
+		return;
+	}
+
+	LLM_SCOPE_BYTAG(Inventory);
+
+	FQueryRequest* Request = nullptr;
+	if (const int32* ExistingIndex = RequestIndexByQuerier.Find(Querier))
+	{
+		Request = &Requests[*ExistingIndex];
+	}
+	else
+	{
+		RequestIndexByQuerier.Add(Querier, Requests.Num());
+		Request = &Requests.AddDefaulted_GetRef();
+		Request->Querier = Querier;
+		Request->QuerierKey = Querier;
+		Request->Results.Reserve(MaxResultsPerRequest);
+	}
+
+	Request->Center = Center;
+	Request->RadiusSquared = FMath::Square(Radius);
+	Request->MaxResults = FMath::Min(MaxResults, MaxResultsPerRequest);
+	Request->LastRequestedSeconds = GetWorld()->GetTimeSeconds();
+}
+
+void UDroppedToolQuerySubsystem::CancelRequest(const UObject* Querier)
+{
+	if (const int32* ExistingIndex = RequestIndexByQuerier.Find(Querier))
+	{
+		RemoveRequestAt(*ExistingIndex);
+	}
+}
+
+TConstArrayView<FDroppedToolQueryResult> UDroppedToolQuerySubsystem::GetCachedResults(const UObject* Querier) const
+{
+	if (const int32* ExistingIndex = RequestIndexByQuerier.Find(Querier))
+	{
+		return Requests[*ExistingIndex].Results;
+	}
+	return {};
+}
+
+bool UDroppedToolQuerySubsystem::HasCachedResults(const UObject* Querier) const
+{
+	const int32* ExistingIndex = RequestIndexByQuerier.Find(Querier);
+	return ExistingIndex && Requests[*ExistingIndex].bEvaluated;
+}
+
+int32 UDroppedToolQuerySubsystem::GetNumRequests() const
+{
+	return Requests.Num();
+}
+
+void UDroppedToolQuerySubsystem::RefreshSnapshot(const UDroppedToolRegistrySubsystem& ToolRegistry)
+{
+	if (bHasSnapshot && SnapshotRevision == ToolRegistry.GetRevision())
+	{
+		return;
+	}
+
+	LLM_SCOPE_BYTAG(Inventory);
+
+	SnapshotX.Reset();
+	SnapshotY.Reset();
+	SnapshotZ.Reset();
+	SnapshotToolIds.Reset();
+	SnapshotLocations.Reset();
+
+	ToolRegistry.ForEachTool([this](const FTrackedTool& TrackedTool)
+	{
+		if (!TrackedTool.bIsDropped)
+		{
+			return;
+		}
+
+		SnapshotX.Add(static_cast<float>(TrackedTool.WorldLocation.X));
+		SnapshotY.Add(static_cast<float>(TrackedTool.WorldLocation.Y));
+		SnapshotZ.Add(static_cast<float>(TrackedTool.WorldLocation.Z));
+		SnapshotToolIds.Add(TrackedTool.ToolId);
+		SnapshotLocations.Add(TrackedTool.WorldLocation);
+	});
+
+	const int32 PaddedNum = Align(SnapshotX.Num(), DroppedToolQuery::LaneCount);
+	while (SnapshotX.Num() < PaddedNum)
+	{
+		SnapshotX.Add(DroppedToolQuery::PaddingCoordinate);
+		SnapshotY.Add(DroppedToolQuery::PaddingCoordinate);
+		SnapshotZ.Add(DroppedToolQuery::PaddingCoordinate);
+	}
+
+	SnapshotRevision = ToolRegistry.GetRevision();
+	bHasSnapshot = true;
+}
+
+void UDroppedToolQuerySubsystem::EvaluateRequest(FQueryRequest& Request)
+{
+	Request.Results.Reset();
+	Request.bEvaluated = true;
+	CandidateHeap.Reset();
+
+	// Max-heap on distance capped at MaxResults, so the farthest kept candidate is always at the top.
+	const auto FarthestFirst = [](const FCandidate& A, const FCandidate& B)
+	{
+		return A.DistanceSquared > B.DistanceSquared;
+	};
+
+	const VectorRegister4Float CenterX = VectorSetFloat1(static_cast<float>(Request.Center.X));
+	const VectorRegister4Float CenterY = VectorSetFloat1(static_cast<float>(Request.Center.Y));
+	const VectorRegister4Float CenterZ = VectorSetFloat1(static_cast<float>(Request.Center.Z));
+	const VectorRegister4Float RadiusSquared = VectorSetFloat1(Request.RadiusSquared);
+
+	const int32 PaddedNum = SnapshotX.Num();
+	for (int32 BaseIndex = 0; BaseIndex < PaddedNum; BaseIndex += DroppedToolQuery::LaneCount)
+	{
+		const VectorRegister4Float DeltaX = VectorSubtract(VectorLoadAligned(SnapshotX.GetData() + BaseIndex), CenterX);
+		const VectorRegister4Float DeltaY = VectorSubtract(VectorLoadAligned(SnapshotY.GetData() + BaseIndex), CenterY);
+		const VectorRegister4Float DeltaZ = VectorSubtract(VectorLoadAligned(SnapshotZ.GetData() + BaseIndex), CenterZ);
+		const VectorRegister4Float DistanceSquared = VectorMultiplyAdd(DeltaZ, DeltaZ, VectorMultiplyAdd(DeltaY, DeltaY, VectorMultiply(DeltaX, DeltaX)));
+
+		const uint32 InRadiusMask = VectorMaskBits(VectorCompareLE(DistanceSquared, RadiusSquared));
+		if (InRadiusMask == 0)
+		{
+			continue;
+		}
+
+		alignas(16) float LaneDistances[DroppedToolQuery::LaneCount];
+		VectorStoreAligned(DistanceSquared, LaneDistances);
+
+		for (int32 Lane = 0; Lane < DroppedToolQuery::LaneCount; ++Lane)
+		{
+			if ((InRadiusMask & (1u << Lane)) == 0)
+			{
+				continue;
+			}
+
+			const FCandidate Candidate{ BaseIndex + Lane, LaneDistances[Lane] };
+			if (CandidateHeap.Num() < Request.MaxResults)
+			{
+				CandidateHeap.HeapPush(Candidate, FarthestFirst);
+			}
+			else if (Candidate.DistanceSquared < CandidateHeap.HeapTop().DistanceSquared)
+			{
+				CandidateHeap.HeapPopDiscard(FarthestFirst, EAllowShrinking::No);
+				CandidateHeap.HeapPush(Candidate, FarthestFirst);
+			}
+		}
+	}
+
+	CandidateHeap.Sort([](const FCandidate& A, const FCandidate& B)
+	{
+		return A.DistanceSquared < B.DistanceSquared;
+	});
+
+	for (const FCandidate& Candidate : CandidateHeap)
+	{
+		Request.Results.Add({ SnapshotToolIds[Candidate.SnapshotIndex], SnapshotLocations[Candidate.SnapshotIndex], Candidate.DistanceSquared });
+	}
+}
+
+void UDroppedToolQuerySubsystem::RemoveRequestAt(int32 RequestIndex)
+{
+	RequestIndexByQuerier.Remove(Requests[RequestIndex].QuerierKey);
+
+	Requests.RemoveAtSwap(RequestIndex, 1, EAllowShrinking::No);
+	if (Requests.IsValidIndex(RequestIndex))
+	{
+		RequestIndexByQuerier.FindChecked(Requests[RequestIndex].QuerierKey) = RequestIndex;
+	}
+}
@@ -0,0 +1,80 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "UObject/ObjectKey.h"
+#include "DroppedToolQuerySubsystem.generated.h"
+
+class UDroppedToolRegistrySubsystem;
+
+struct FDroppedToolQueryResult
+{
+	FGuid ToolId;
+	FVector WorldLocation = FVector::ZeroVector;
+	float DistanceSquared = 0.0f;
+};
+
+// Server-side batched "nearest N dropped tools within radius" for AI. Each querier keeps one standing
+// request; all requests are evaluated together against a SoA snapshot of the dropped tool registry
+// in a time-sliced pass each frame, and results stay cached until the request is next evaluated.
+UCLASS()
+class COWFIELDCLEANUP_API UDroppedToolQuerySubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	static constexpr int32 MaxResultsPerRequest = 16;
+
+	virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+	virtual void Deinitialize() override;
+	virtual void Tick(float DeltaTime) override;
+	virtual bool IsTickable() const override;
+	virtual TStatId GetStatId() const override;
+
+	// Adds or refreshes the querier's request. Requests that are not refreshed for a few seconds are dropped.
+	void RequestNearestTools(const UObject* Querier, const FVector& Center, float Radius, int32 MaxResults);
+	void CancelRequest(const UObject* Querier);
+
+	// Nearest first, as of the last pass that evaluated this querier's request; empty until the first one has.
+	TConstArrayView<FDroppedToolQueryResult> GetCachedResults(const UObject* Querier) const;
+	bool HasCachedResults(const UObject* Querier) const;
+	int32 GetNumRequests() const;
+
+private:
+	struct FQueryRequest
+	{
+		TWeakObjectPtr<const UObject> Querier;
+		TObjectKey<UObject> QuerierKey;
+		FVector Center = FVector::ZeroVector;
+		float RadiusSquared = 0.0f;
+		int32 MaxResults = 1;
+		double LastRequestedSeconds = 0.0;
+		bool bEvaluated = false;
+		TArray<FDroppedToolQueryResult> Results;
+	};
+
+	struct FCandidate
+	{
+		int32 SnapshotIndex = INDEX_NONE;
+		float DistanceSquared = 0.0f;
+	};
+
+	void RefreshSnapshot(const UDroppedToolRegistrySubsystem& ToolRegistry);
+	void EvaluateRequest(FQueryRequest& Request);
+	void RemoveRequestAt(int32 RequestIndex);
+
+	TArray<FQueryRequest> Requests;
+	TMap<TObjectKey<UObject>, int32> RequestIndexByQuerier;
+	int32 NextRequestIndex = 0;
+
+	// Dropped tool positions split by axis and padded to a multiple of four lanes for the distance kernel.
+	TArray<float, TAlignedHeapAllocator<16>> SnapshotX;
+	TArray<float, TAlignedHeapAllocator<16>> SnapshotY;
+	TArray<float, TAlignedHeapAllocator<16>> SnapshotZ;
+	TArray<FGuid> SnapshotToolIds;
+	TArray<FVector> SnapshotLocations;
+	uint32 SnapshotRevision = 0;
+	bool bHasSnapshot = false;
+
+	TArray<FCandidate> CandidateHeap;
+};
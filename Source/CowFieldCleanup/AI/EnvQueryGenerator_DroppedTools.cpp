@@ -0,0 +1,59 @@
+#include "AI/EnvQueryGenerator_DroppedTools.h"
+
+#include "AI/DroppedToolQuerySubsystem.h"
+#include "Engine/World.h"
+#include "EnvironmentQuery/Contexts/EnvQueryContext_Querier.h"
+#include "EnvironmentQuery/Items/EnvQueryItemType_Point.h"
+
+#define LOCTEXT_NAMESPACE "CowFieldCleanupEnvQueryGenerator"
+
+UEnvQueryGenerator_DroppedTools::UEnvQueryGenerator_DroppedTools(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer)
+{
+	ItemType = UEnvQueryItemType_Point::StaticClass();
+	SearchCenter = UEnvQueryContext_Querier::StaticClass();
+	SearchRadius.DefaultValue = 3000.0f;
+	MaxTools.DefaultValue = 4;
+}
+
+void UEnvQueryGenerator_DroppedTools::GenerateItems(FEnvQueryInstance& QueryInstance) const
+{
+	UObject* QueryOwner = QueryInstance.Owner.Get();
+	UDroppedToolQuerySubsystem* QuerySubsystem = QueryInstance.World ? QueryInstance.World->GetSubsystem<UDroppedToolQuerySubsystem>() : nullptr;
+	if (!QueryOwner || !QuerySubsystem)
+	{
+		return;
+	}
+
+	SearchRadius.BindData(QueryOwner, QueryInstance.QueryID);
+	MaxTools.BindData(QueryOwner, QueryInstance.QueryID);
+
+	TArray<FVector> ContextLocations;
+	QueryInstance.PrepareContext(SearchCenter, ContextLocations);
+	if (ContextLocations.IsEmpty())
+	{
+		return;
+	}
+
+	// One standing request per querier; a multi-location context searches around its first location.
+	QuerySubsystem->RequestNearestTools(QueryOwner, ContextLocations[0], SearchRadius.GetValue(), MaxTools.GetValue());
+
+	for (const FDroppedToolQueryResult& Result : QuerySubsystem->GetCachedResults(QueryOwner))
+	{
+		QueryInstance.AddItemData<UEnvQueryItemType_Point>(Result.WorldLocation);
+	}
+}
+
+FText UEnvQueryGenerator_DroppedTools::GetDescriptionTitle() const
+{
+	return FText::Format(LOCTEXT("DescriptionTitle", "{0}: nearest dropped tools around {1}"),
+		Super::GetDescriptionTitle(), UEnvQueryTypes::DescribeContext(SearchCenter));
+}
+
+FText UEnvQueryGenerator_DroppedTools::GetDescriptionDetails() const
+{
+	return FText::Format(LOCTEXT("DescriptionDetails", "radius: {0}, max tools: {1}"),
+		FText::FromString(SearchRadius.ToString()), FText::FromString(MaxTools.ToString()));
+}
+
+#undef LOCTEXT_NAMESPACE
@@ -0,0 +1,33 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "DataProviders/AIDataProvider.h"
+#include "EnvironmentQuery/EnvQueryGenerator.h"
+#include "EnvQueryGenerator_DroppedTools.generated.h"
+
+class UEnvQueryContext;
+
+// Points at the dropped tools nearest the search center, read from UDroppedToolQuerySubsystem's batched pass.
+// The querier's standing request is refreshed on every run, so results trail the search center by one pass.
+UCLASS(meta = (DisplayName = "Dropped Tools"))
+class COWFIELDCLEANUP_API UEnvQueryGenerator_DroppedTools : public UEnvQueryGenerator
+{
+	GENERATED_BODY()
+
+public:
+	UEnvQueryGenerator_DroppedTools(const FObjectInitializer& ObjectInitializer = FObjectInitializer::Get());
+
+	virtual void GenerateItems(FEnvQueryInstance& QueryInstance) const override;
+	virtual FText GetDescriptionTitle() const override;
+	virtual FText GetDescriptionDetails() const override;
+
+protected:
+	UPROPERTY(EditDefaultsOnly, Category = Generator)
+	TSubclassOf<UEnvQueryContext> SearchCenter;
+
+	UPROPERTY(EditDefaultsOnly, Category = Generator)
+	FAIDataProviderFloatValue SearchRadius;
+
+	UPROPERTY(EditDefaultsOnly, Category = Generator, meta = (ClampMin = "1", ClampMax = "16"))
+	FAIDataProviderIntValue MaxTools;
+};
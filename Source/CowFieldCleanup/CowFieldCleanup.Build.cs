@@ -20,6 +20,11 @@ public class CowFieldCleanup : ModuleRules
 		PrivateDependencyModuleNames.AddRange(
 			new string[]
 			{
+				"AIModule",
+				"AssetRegistry",
+				"DeveloperSettings",
+				"Json",
+				"ReplicationGraph",
 				"Slate",
 				"SlateCore"
 			}
@@ -1,13 +1,22 @@
 #include "CowFieldCleanup.h"
 
+#include "Engine/ReplicationDriver.h"
+#include "Inventory/InventoryStats.h"
 #include "Modules/ModuleManager.h"
+#include "Replication/CowFieldCleanupReplicationGraph.h"
 
 IMPLEMENT_PRIMARY_GAME_MODULE(FCowFieldCleanupModule, CowFieldCleanup, "CowFieldCleanup");
 
+DEFINE_LOG_CATEGORY(LogCowFieldCleanup);
+
 void FCowFieldCleanupModule::StartupModule()
 {
+	InventoryStats::StartPublishing();
+	UReplicationDriver::CreateReplicationDriverDelegate().BindStatic(&UCowFieldCleanupReplicationGraph::CreateForNetDriver);
 }
 
 void FCowFieldCleanupModule::ShutdownModule()
 {
+	UReplicationDriver::CreateReplicationDriverDelegate().Unbind();
+	InventoryStats::StopPublishing();
 }
@@ -2,6 +2,8 @@
 
 #include "Modules/ModuleManager.h"
 
+DECLARE_LOG_CATEGORY_EXTERN(LogCowFieldCleanup, Log, All);
+
 class FCowFieldCleanupModule : public FDefaultGameModuleImpl
 {
 public:
@@ -1 +1,55 @@
 #include "DataAssets/InventoryBalanceDataAsset.h"
+
+#include "Curves/CurveFloat.h"
+
+const FPrimaryAssetType UInventoryBalanceDataAsset::PrimaryAssetType(TEXT("InventoryBalance"));
+
+FPrimaryAssetId UInventoryBalanceDataAsset::GetPrimaryAssetId() const
+{
+	return FPrimaryAssetId(PrimaryAssetType, GetFName());
+}
+
+void UInventoryBalanceDataAsset::PostLoad()
+{
+	Super::PostLoad();
+
+	if (MovementSpeedByWeight)
+	{
+		MovementSpeedByWeight->ConditionalPostLoad();
+	}
+
+	if (StaminaDrainMultiplierByWeight)
+	{
+		StaminaDrainMultiplierByWeight->ConditionalPostLoad();
+	}
+
+	RebuildCompiledProfile();
+}
+
+#if WITH_EDITOR
+void UInventoryBalanceDataAsset::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+	Super::PostEditChangeProperty(PropertyChangedEvent);
+
+	RebuildCompiledProfile();
+}
+#endif
+
+TSharedRef<const FInventoryBalanceProfile> UInventoryBalanceDataAsset::GetCompiledProfile() const
+{
+	if (!CompiledProfile.IsValid())
+	{
+		CompiledProfile = FInventoryBalanceProfile::Build(*this);
+	}
+
+	return CompiledProfile.ToSharedRef();
+}
+
+void UInventoryBalanceDataAsset::RebuildCompiledProfile()
+{
+	CompiledProfile = FInventoryBalanceProfile::Build(*this);
+
+#if WITH_EDITOR
+	OnCompiledProfileRebuilt.Broadcast();
+#endif
+}
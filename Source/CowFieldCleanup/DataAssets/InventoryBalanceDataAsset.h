@@ -1,21 +1,42 @@
 #pragma once
 
 #include "CoreMinimal.h"
-#include "Engine/DataAsset.h"
+#include "DataAssets/InventoryBalanceProfile.h"
+#include "Engine/PrimaryDataAsset.h"
 #include "InventoryBalanceDataAsset.generated.h"
 
+class UCurveFloat;
+
 UCLASS(BlueprintType)
-class COWFIELDCLEANUP_API UInventoryBalanceDataAsset : public UDataAsset
+class COWFIELDCLEANUP_API UInventoryBalanceDataAsset : public UPrimaryDataAsset
 {
 	GENERATED_BODY()
 
 public:
+	static const FPrimaryAssetType PrimaryAssetType;
+
+	virtual FPrimaryAssetId GetPrimaryAssetId() const override;
+	virtual void PostLoad() override;
+
+#if WITH_EDITOR
+	virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+
+	FSimpleMulticastDelegate OnCompiledProfileRebuilt;
+#endif
+
+	TSharedRef<const FInventoryBalanceProfile> GetCompiledProfile() const;
+	void RebuildCompiledProfile();
+
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Bag|Capacity")
 	int32 MaxToolSlots = 3;
 
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Bag|Capacity")
 	float MaxBagWeight = 0.0f;
 
+	// Stacks the bag holds across all items, each up to the item's stack size; 0 means no limit.
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Bag|Capacity", meta = (ClampMin = "0"))
+	int32 MaxBagStacks = 0;
+
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Bag|Curves")
 	TObjectPtr<UCurveFloat> MovementSpeedByWeight;
 
@@ -30,4 +51,50 @@ public:
 
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Locator")
 	float MediumDistance = 0.0f;
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Locator|Streaming", meta = (ClampMin = "0.0"))
+	float DroppedToolMinSendDistance = 25.0f;
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Locator|Streaming", meta = (ClampMin = "0.0"))
+	float DroppedToolSendsPerSecond = 4.0f;
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Locator|Streaming", meta = (ClampMin = "1.0"))
+	float DroppedToolSendBurst = 2.0f;
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Locator|Tracking", meta = (ClampMin = "0.0"))
+	float TrackingIntervalNear = 0.1f;
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Locator|Tracking", meta = (ClampMin = "0.0"))
+	float TrackingIntervalMedium = 0.25f;
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Locator|Tracking", meta = (ClampMin = "0.0"))
+	float TrackingIntervalFar = 0.75f;
+
+	// Unchanged tracking state is re-sent this often so a dropped unreliable update cannot leave the client stale.
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Locator|Tracking", meta = (ClampMin = "0.1"))
+	float TrackingKeepAliveSeconds = 2.0f;
+
+	// Only honoured when the owning actor does not replicate movement (e.g. a player state), since dormancy stops all of its replication.
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Replication")
+	bool bOwnerDormantWhileIdle = false;
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Replication", meta = (ClampMin = "0.1", EditCondition = "bOwnerDormantWhileIdle"))
+	float IdleDormancySeconds = 3.0f;
+
+	// Batched slot and bag operations; a batch costs one token per op.
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Replication|Rate Limits")
+	FInventoryRpcRateLimit InventoryRpcRateLimit = FInventoryRpcRateLimit(30.0f, 64.0f);
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Replication|Rate Limits")
+	FInventoryRpcRateLimit DroppedToolRpcRateLimit = FInventoryRpcRateLimit(60.0f, 120.0f);
+
+	// Unreliable position updates for moving dropped tools; register, settle and remove use the limit above.
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Replication|Rate Limits")
+	FInventoryRpcRateLimit DroppedToolStreamRpcRateLimit = FInventoryRpcRateLimit(60.0f, 120.0f);
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Replication|Rate Limits")
+	FInventoryRpcRateLimit LocatorRpcRateLimit = FInventoryRpcRateLimit(4.0f, 8.0f);
+
+private:
+	mutable TSharedPtr<const FInventoryBalanceProfile> CompiledProfile;
 };
@@ -0,0 +1,143 @@
+#include "DataAssets/InventoryBalanceProfile.h"
+
+#include "Curves/CurveFloat.h"
+#include "DataAssets/InventoryBalanceDataAsset.h"
+
+TSharedRef<const FInventoryBalanceProfile> FInventoryBalanceProfile::Build(const UInventoryBalanceDataAsset& BalanceData)
+{
+	TSharedRef<FInventoryBalanceProfile> Profile = MakeShared<FInventoryBalanceProfile>();
+	Profile->MaxToolSlots = BalanceData.MaxToolSlots;
+	Profile->MaxBagWeight = BalanceData.MaxBagWeight;
+	Profile->MaxBagStacks = FMath::Max(0, BalanceData.MaxBagStacks);
+	Profile->LocateCooldownSeconds = BalanceData.LocateCooldownSeconds;
+	Profile->NearDistance = BalanceData.NearDistance;
+	Profile->MediumDistance = BalanceData.MediumDistance;
+	Profile->NearDistanceSquared = FMath::Square(BalanceData.NearDistance);
+	Profile->MediumDistanceSquared = FMath::Square(BalanceData.MediumDistance);
+	Profile->DroppedToolMinSendDistanceSquared = FMath::Square(BalanceData.DroppedToolMinSendDistance);
+	Profile->DroppedToolSendsPerSecond = BalanceData.DroppedToolSendsPerSecond;
+	Profile->DroppedToolSendBurst = FMath::Max(1.0f, BalanceData.DroppedToolSendBurst);
+	Profile->LocatorTrackingIntervalNear = BalanceData.TrackingIntervalNear;
+	Profile->LocatorTrackingIntervalMedium = BalanceData.TrackingIntervalMedium;
+	Profile->LocatorTrackingIntervalFar = BalanceData.TrackingIntervalFar;
+	Profile->LocatorTrackingKeepAliveSeconds = FMath::Max(0.1f, BalanceData.TrackingKeepAliveSeconds);
+	Profile->bOwnerDormantWhileIdle = BalanceData.bOwnerDormantWhileIdle;
+	Profile->IdleDormancySeconds = FMath::Max(0.1f, BalanceData.IdleDormancySeconds);
+	Profile->RpcRateLimits[static_cast<int32>(EInventoryRpcFamily::Inventory)] = BalanceData.InventoryRpcRateLimit;
+	Profile->RpcRateLimits[static_cast<int32>(EInventoryRpcFamily::DroppedTool)] = BalanceData.DroppedToolRpcRateLimit;
+	Profile->RpcRateLimits[static_cast<int32>(EInventoryRpcFamily::DroppedToolStream)] = BalanceData.DroppedToolStreamRpcRateLimit;
+	Profile->RpcRateLimits[static_cast<int32>(EInventoryRpcFamily::Locator)] = BalanceData.LocatorRpcRateLimit;
+	for (FInventoryRpcRateLimit& RateLimit : Profile->RpcRateLimits)
+	{
+		RateLimit.TokensPerSecond = FMath::Max(0.0f, RateLimit.TokensPerSecond);
+		RateLimit.Burst = FMath::Max(1.0f, RateLimit.Burst);
+	}
+	Profile->MovementSpeedByWeight.Bake(BalanceData.MovementSpeedByWeight, BalanceData.MaxBagWeight);
+	Profile->StaminaDrainMultiplierByWeight.Bake(BalanceData.StaminaDrainMultiplierByWeight, BalanceData.MaxBagWeight);
+	return Profile;
+}
+
+const TSharedRef<const FInventoryBalanceProfile>& FInventoryBalanceProfile::GetDefault()
+{
+	static const TSharedRef<const FInventoryBalanceProfile> DefaultProfile = MakeShared<FInventoryBalanceProfile>();
+	return DefaultProfile;
+}
+
+float FInventoryBalanceProfile::GetMovementSpeedMultiplier(float BagWeight) const
+{
+	return MovementSpeedByWeight.Evaluate(BagWeight);
+}
+
+float FInventoryBalanceProfile::GetStaminaDrainMultiplier(float BagWeight) const
+{
+	return StaminaDrainMultiplierByWeight.Evaluate(BagWeight);
+}
+
+ELocatorDistanceBand FInventoryBalanceProfile::ResolveDistanceBandSquared(float DistanceSquared) const
+{
+	if (NearDistance <= 0.0f || MediumDistance <= 0.0f)
+	{
+		return ELocatorDistanceBand::Unknown;
+	}
+
+	if (DistanceSquared <= NearDistanceSquared)
+	{
+		return ELocatorDistanceBand::Near;
+	}
+
+	if (DistanceSquared <= MediumDistanceSquared)
+	{
+		return ELocatorDistanceBand::Medium;
+	}
+
+	return ELocatorDistanceBand::Far;
+}
+
+float FInventoryBalanceProfile::GetLocatorTrackingInterval(ELocatorDistanceBand DistanceBand) const
+{
+	switch (DistanceBand)
+	{
+	case ELocatorDistanceBand::Near:
+		return LocatorTrackingIntervalNear;
+
+	case ELocatorDistanceBand::Medium:
+		return LocatorTrackingIntervalMedium;
+
+	default:
+		return LocatorTrackingIntervalFar;
+	}
+}
+
+void FInventoryBalanceProfile::FBakedCurve::Bake(const UCurveFloat* Curve, float InMaxInput)
+{
+	Samples.Reset();
+	MaxInput = 0.0f;
+	InputToSample = 0.0f;
+
+	if (!Curve)
+	{
+		return;
+	}
+
+	MaxInput = InMaxInput;
+	if (MaxInput <= 0.0f)
+	{
+		float MinTime = 0.0f;
+		Curve->GetTimeRange(MinTime, MaxInput);
+	}
+
+	if (MaxInput <= 0.0f)
+	{
+		Samples.Add(Curve->GetFloatValue(0.0f));
+		return;
+	}
+
+	InputToSample = (CurveResolution - 1) / MaxInput;
+	for (int32 SampleIndex = 0; SampleIndex < CurveResolution; ++SampleIndex)
+	{
+		Samples.Add(Curve->GetFloatValue(SampleIndex / InputToSample));
+	}
+}
+
+float FInventoryBalanceProfile::FBakedCurve::Evaluate(float Input) const
+{
+	if (Samples.IsEmpty())
+	{
+		return 1.0f;
+	}
+
+	if (Samples.Num() == 1)
+	{
+		return Samples[0];
+	}
+
+	const float SamplePosition = FMath::Clamp(Input, 0.0f, MaxInput) * InputToSample;
+	const int32 LowerIndex = FMath::Min(FMath::FloorToInt32(SamplePosition), CurveResolution - 2);
+	return FMath::Lerp(Samples[LowerIndex], Samples[LowerIndex + 1], SamplePosition - LowerIndex);
+}
+
+const FInventoryRpcRateLimit& FInventoryBalanceProfile::GetRpcRateLimit(EInventoryRpcFamily Family) const
+{
+	check(Family < EInventoryRpcFamily::Num);
+	return RpcRateLimits[static_cast<int32>(Family)];
+}
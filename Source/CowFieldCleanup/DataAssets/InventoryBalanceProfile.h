@@ -0,0 +1,61 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Inventory/InventoryTypes.h"
+
+class UCurveFloat;
+class UInventoryBalanceDataAsset;
+
+class COWFIELDCLEANUP_API FInventoryBalanceProfile
+{
+public:
+	static constexpr int32 CurveResolution = 64;
+
+	static TSharedRef<const FInventoryBalanceProfile> Build(const UInventoryBalanceDataAsset& BalanceData);
+	static const TSharedRef<const FInventoryBalanceProfile>& GetDefault();
+
+	float GetMovementSpeedMultiplier(float BagWeight) const;
+	float GetStaminaDrainMultiplier(float BagWeight) const;
+	ELocatorDistanceBand ResolveDistanceBandSquared(float DistanceSquared) const;
+	float GetLocatorTrackingInterval(ELocatorDistanceBand DistanceBand) const;
+	const FInventoryRpcRateLimit& GetRpcRateLimit(EInventoryRpcFamily Family) const;
+
+	int32 MaxToolSlots = 3;
+	float MaxBagWeight = 0.0f;
+	int32 MaxBagStacks = 0;
+	float LocateCooldownSeconds = 0.0f;
+	float NearDistance = 0.0f;
+	float MediumDistance = 0.0f;
+	float NearDistanceSquared = 0.0f;
+	float MediumDistanceSquared = 0.0f;
+	float DroppedToolMinSendDistanceSquared = FMath::Square(25.0f);
+	float DroppedToolSendsPerSecond = 4.0f;
+	float DroppedToolSendBurst = 2.0f;
+	float LocatorTrackingIntervalNear = 0.1f;
+	float LocatorTrackingIntervalMedium = 0.25f;
+	float LocatorTrackingIntervalFar = 0.75f;
+	float LocatorTrackingKeepAliveSeconds = 2.0f;
+	bool bOwnerDormantWhileIdle = false;
+	float IdleDormancySeconds = 3.0f;
+	FInventoryRpcRateLimit RpcRateLimits[static_cast<int32>(EInventoryRpcFamily::Num)] =
+	{
+		FInventoryRpcRateLimit(30.0f, 64.0f),
+		FInventoryRpcRateLimit(60.0f, 120.0f),
+		FInventoryRpcRateLimit(60.0f, 120.0f),
+		FInventoryRpcRateLimit(4.0f, 8.0f)
+	};
+
+private:
+	struct FBakedCurve
+	{
+		void Bake(const UCurveFloat* Curve, float MaxInput);
+		float Evaluate(float Input) const;
+
+		TArray<float, TFixedAllocator<CurveResolution>> Samples;
+		float MaxInput = 0.0f;
+		float InputToSample = 0.0f;
+	};
+
+	FBakedCurve MovementSpeedByWeight;
+	FBakedCurve StaminaDrainMultiplierByWeight;
+};
@@ -1 +1,23 @@
 #include "DataAssets/ItemDefinitionDataAsset.h"
+
+const FPrimaryAssetType UItemDefinitionDataAsset::PrimaryAssetType(TEXT("ItemDefinition"));
+
+FPrimaryAssetId UItemDefinitionDataAsset::GetPrimaryAssetId() const
+{
+	return FPrimaryAssetId(PrimaryAssetType, GetFName());
+}
+
+int32 UItemDefinitionDataAsset::GetStackSize() const
+{
+	if (!bStackable)
+	{
+		return 1;
+	}
+
+	return MaxStackSize > 0 ? MaxStackSize : MAX_int32;
+}
+
+int32 UItemDefinitionDataAsset::GetNumStacks(int32 Quantity) const
+{
+	return Quantity > 0 ? 1 + (Quantity - 1) / GetStackSize() : 0;
+}
@@ -5,13 +5,28 @@
 #include "Inventory/InventoryTypes.h"
 #include "ItemDefinitionDataAsset.generated.h"
 
+class UStaticMesh;
+class UTexture2D;
+
 UCLASS(BlueprintType)
 class COWFIELDCLEANUP_API UItemDefinitionDataAsset : public UPrimaryDataAsset
 {
 	GENERATED_BODY()
 
 public:
-	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Item")
+	static const FPrimaryAssetType PrimaryAssetType;
+
+	virtual FPrimaryAssetId GetPrimaryAssetId() const override;
+
+	// Units per bag stack: 1 for non-stackable items, MaxStackSize otherwise, unlimited when MaxStackSize is 0.
+	int32 GetStackSize() const;
+
+	// Stacks that Quantity units of this item take up in the bag. The bag keeps one entry per item with the full
+	// quantity; stacks are only derived for display and for UInventoryBalanceDataAsset::MaxBagStacks.
+	UFUNCTION(BlueprintPure, Category = "Item")
+	int32 GetNumStacks(int32 Quantity) const;
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Item", AssetRegistrySearchable)
 	FName ItemId;
 
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Item")
@@ -26,6 +41,13 @@ public:
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Item")
 	bool bStackable = true;
 
-	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Item", meta = (EditCondition = "bStackable"))
+	// Units per bag stack; 0 means one stack holds any amount.
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Item", meta = (EditCondition = "bStackable", ClampMin = "0"))
 	int32 MaxStackSize = 0;
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Item|Presentation", meta = (AssetBundles = "UI"))
+	TSoftObjectPtr<UTexture2D> Icon;
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Item|Presentation", meta = (AssetBundles = "Field"))
+	TSoftObjectPtr<UStaticMesh> WorldMesh;
 };
@@ -0,0 +1,203 @@
+#include "Game/CowFieldCleanupGameState.h"
+
+#include "DataAssets/ItemDefinitionDataAsset.h"
+#include "Inventory/InventoryStats.h"
+#include "Net/Core/PushModel/PushModel.h"
+#include "Net/UnrealNetwork.h"
+
+void ACowFieldCleanupGameState::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
+{
+	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
+
+	FDoRepLifetimeParams SharedParams;
+	SharedParams.bIsPushBased = true;
+
+	DOREPLIFETIME_WITH_PARAMS_FAST(ACowFieldCleanupGameState, CleanupProgress, SharedParams); // Team totals, per-item totals and player loads
+}
+
+void ACowFieldCleanupGameState::ApplyInventoryDelta(int32 PlayerId, const UItemDefinitionDataAsset* ItemDefinition, int32 QuantityDelta)
+{
+	if (!HasAuthority() || !ItemDefinition || QuantityDelta == 0)
+	{
+		return;
+	}
+
+	const float WeightDelta = ItemDefinition->ItemWeight * QuantityDelta;
+	int32& CategoryQuantity = CleanupProgress.QuantityByCategory[static_cast<int32>(ItemDefinition->Category)];
+	CategoryQuantity = FMath::Max(0, CategoryQuantity + QuantityDelta);
+
+	ApplyItemTotalDelta(ItemDefinition, QuantityDelta);
+	ApplyPlayerLoadDelta(PlayerId, QuantityDelta, WeightDelta);
+
+	// Signed float deltas drift; snap back to exactly empty once the team carries nothing.
+	CleanupProgress.TotalBagWeight = CleanupProgress.ItemTotals.IsEmpty() ? 0.0f : FMath::Max(0.0f, CleanupProgress.TotalBagWeight + WeightDelta);
+
+	MarkCleanupProgressDirty();
+}
+
+void ACowFieldCleanupGameState::ReassignPlayerLoad(int32 OldPlayerId, int32 NewPlayerId)
+{
+	if (!HasAuthority() || OldPlayerId == NewPlayerId)
+	{
+		return;
+	}
+
+	const int32 OldIndex = CleanupProgress.PlayerLoads.IndexOfByPredicate([OldPlayerId](const FPlayerCleanupLoad& Candidate) { return Candidate.PlayerId == OldPlayerId; });
+	if (OldIndex == INDEX_NONE)
+	{
+		return;
+	}
+
+	const FPlayerCleanupLoad OldLoad = CleanupProgress.PlayerLoads[OldIndex];
+	CleanupProgress.PlayerLoads.RemoveAt(OldIndex, 1, EAllowShrinking::No);
+	ApplyPlayerLoadDelta(NewPlayerId, OldLoad.ItemCount, OldLoad.BagWeight);
+	MarkCleanupProgressDirty();
+}
+
+void ACowFieldCleanupGameState::SetCleanupTarget(int32 TargetQuantity)
+{
+	if (!HasAuthority())
+	{
+		return;
+	}
+
+	CleanupProgress.TargetCleanupQuantity = FMath::Max(0, TargetQuantity);
+	MarkCleanupProgressDirty();
+}
+
+const FTeamCleanupProgress& ACowFieldCleanupGameState::GetCleanupProgress() const
+{
+	return CleanupProgress;
+}
+
+float ACowFieldCleanupGameState::GetCleanupFraction() const
+{
+	if (CleanupProgress.TargetCleanupQuantity <= 0)
+	{
+		return 0.0f;
+	}
+
+	return FMath::Min(1.0f, static_cast<float>(GetCategoryQuantity(EInventoryItemCategory::Cleanup)) / CleanupProgress.TargetCleanupQuantity);
+}
+
+bool ACowFieldCleanupGameState::IsCleanupComplete() const
+{
+	return CleanupProgress.TargetCleanupQuantity > 0 && GetCategoryQuantity(EInventoryItemCategory::Cleanup) >= CleanupProgress.TargetCleanupQuantity;
+}
+
+int32 ACowFieldCleanupGameState::GetCategoryQuantity(EInventoryItemCategory Category) const
+{
+	const int32 CategoryIndex = static_cast<int32>(Category);
+	return CategoryIndex < static_cast<int32>(UE_ARRAY_COUNT(CleanupProgress.QuantityByCategory)) ? CleanupProgress.QuantityByCategory[CategoryIndex] : 0;
+}
+
+int32 ACowFieldCleanupGameState::GetTeamItemQuantity(const UItemDefinitionDataAsset* ItemDefinition) const
+{
+	const int32* ItemIndex = ItemTotalIndexByDefinition.Find(ItemDefinition);
+	return ItemIndex ? CleanupProgress.ItemTotals[*ItemIndex].Quantity : 0;
+}
+
+bool ACowFieldCleanupGameState::GetHeaviestLoadedPlayer(FPlayerCleanupLoad& OutPlayerLoad) const
+{
+	if (CleanupProgress.PlayerLoads.IsEmpty())
+	{
+		return false;
+	}
+
+	OutPlayerLoad = CleanupProgress.PlayerLoads[0];
+	return true;
+}
+
+void ACowFieldCleanupGameState::OnRep_CleanupProgress()
+{
+	RebuildItemTotalIndex();
+	OnCleanupProgressChanged.Broadcast(CleanupProgress);
+}
+
+void ACowFieldCleanupGameState::ApplyItemTotalDelta(const UItemDefinitionDataAsset* ItemDefinition, int32 QuantityDelta)
+{
+	TArray<FTeamItemTotal>& ItemTotals = CleanupProgress.ItemTotals;
+	if (const int32* ExistingIndex = ItemTotalIndexByDefinition.Find(ItemDefinition))
+	{
+		const int32 ItemIndex = *ExistingIndex;
+		ItemTotals[ItemIndex].Quantity += QuantityDelta;
+		if (ItemTotals[ItemIndex].Quantity > 0)
+		{
+			return;
+		}
+
+		ItemTotalIndexByDefinition.Remove(ItemDefinition);
+		ItemTotals.RemoveAtSwap(ItemIndex, 1, EAllowShrinking::No);
+		if (ItemTotals.IsValidIndex(ItemIndex))
+		{
+			ItemTotalIndexByDefinition.FindChecked(ItemTotals[ItemIndex].ItemDefinition.Get()) = ItemIndex;
+		}
+		return;
+	}
+
+	if (QuantityDelta <= 0)
+	{
+		return;
+	}
+
+	LLM_SCOPE_BYTAG(Inventory);
+	ItemTotalIndexByDefinition.Add(ItemDefinition, ItemTotals.Num());
+	FTeamItemTotal& NewTotal = ItemTotals.AddDefaulted_GetRef();
+	NewTotal.ItemDefinition = const_cast<UItemDefinitionDataAsset*>(ItemDefinition);
+	NewTotal.Quantity = QuantityDelta;
+}
+
+void ACowFieldCleanupGameState::ApplyPlayerLoadDelta(int32 PlayerId, int32 QuantityDelta, float WeightDelta)
+{
+	TArray<FPlayerCleanupLoad>& PlayerLoads = CleanupProgress.PlayerLoads;
+	int32 LoadIndex = PlayerLoads.IndexOfByPredicate([PlayerId](const FPlayerCleanupLoad& Candidate) { return Candidate.PlayerId == PlayerId; });
+	if (LoadIndex == INDEX_NONE)
+	{
+		if (QuantityDelta <= 0)
+		{
+			return;
+		}
+
+		LLM_SCOPE_BYTAG(Inventory);
+		LoadIndex = PlayerLoads.AddDefaulted();
+		PlayerLoads[LoadIndex].PlayerId = PlayerId;
+	}
+
+	FPlayerCleanupLoad& PlayerLoad = PlayerLoads[LoadIndex];
+	PlayerLoad.ItemCount += QuantityDelta;
+	if (PlayerLoad.ItemCount <= 0)
+	{
+		PlayerLoads.RemoveAt(LoadIndex, 1, EAllowShrinking::No);
+		return;
+	}
+
+	PlayerLoad.BagWeight = FMath::Max(0.0f, PlayerLoad.BagWeight + WeightDelta);
+
+	// One delta moves one player, so a single insertion pass keeps the list sorted heaviest first.
+	while (LoadIndex > 0 && PlayerLoads[LoadIndex - 1].BagWeight < PlayerLoads[LoadIndex].BagWeight)
+	{
+		Swap(PlayerLoads[LoadIndex - 1], PlayerLoads[LoadIndex]);
+		--LoadIndex;
+	}
+
+	while (LoadIndex + 1 < PlayerLoads.Num() && PlayerLoads[LoadIndex + 1].BagWeight > PlayerLoads[LoadIndex].BagWeight)
+	{
+		Swap(PlayerLoads[LoadIndex + 1], PlayerLoads[LoadIndex]);
+		++LoadIndex;
+	}
+}
+
+void ACowFieldCleanupGameState::RebuildItemTotalIndex()
+{
+	ItemTotalIndexByDefinition.Reset();
+	for (int32 ItemIndex = 0; ItemIndex < CleanupProgress.ItemTotals.Num(); ++ItemIndex)
+	{
+		ItemTotalIndexByDefinition.Add(CleanupProgress.ItemTotals[ItemIndex].ItemDefinition.Get(), ItemIndex);
+	}
+}
+
+void ACowFieldCleanupGameState::MarkCleanupProgressDirty()
+{
+	MARK_PROPERTY_DIRTY_FROM_NAME(ACowFieldCleanupGameState, CleanupProgress, this);
+	OnCleanupProgressChanged.Broadcast(CleanupProgress);
+}
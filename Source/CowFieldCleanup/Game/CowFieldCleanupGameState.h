@@ -0,0 +1,64 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/GameState.h"
+#include "Inventory/InventoryTypes.h"
+#include "UObject/ObjectKey.h"
+#include "CowFieldCleanupGameState.generated.h"
+
+class UItemDefinitionDataAsset;
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnTeamCleanupProgressChanged, const FTeamCleanupProgress&, Progress);
+
+UCLASS()
+class COWFIELDCLEANUP_API ACowFieldCleanupGameState : public AGameState
+{
+	GENERATED_BODY()
+
+public:
+	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
+
+	// Server only. Called by UInventoryComponent whenever a bag entry changes on authority.
+	void ApplyInventoryDelta(int32 PlayerId, const UItemDefinitionDataAsset* ItemDefinition, int32 QuantityDelta);
+
+	// Server only. Moves a player's load when their pawn picks up a player id after items were already counted.
+	void ReassignPlayerLoad(int32 OldPlayerId, int32 NewPlayerId);
+
+	UFUNCTION(BlueprintCallable, BlueprintAuthorityOnly, Category = "Cleanup")
+	void SetCleanupTarget(int32 TargetQuantity);
+
+	UFUNCTION(BlueprintPure, Category = "Cleanup")
+	const FTeamCleanupProgress& GetCleanupProgress() const;
+
+	UFUNCTION(BlueprintPure, Category = "Cleanup")
+	float GetCleanupFraction() const;
+
+	UFUNCTION(BlueprintPure, Category = "Cleanup")
+	bool IsCleanupComplete() const;
+
+	UFUNCTION(BlueprintPure, Category = "Cleanup")
+	int32 GetCategoryQuantity(EInventoryItemCategory Category) const;
+
+	UFUNCTION(BlueprintPure, Category = "Cleanup")
+	int32 GetTeamItemQuantity(const UItemDefinitionDataAsset* ItemDefinition) const;
+
+	UFUNCTION(BlueprintPure, Category = "Cleanup")
+	bool GetHeaviestLoadedPlayer(FPlayerCleanupLoad& OutPlayerLoad) const;
+
+	UPROPERTY(BlueprintAssignable, Category = "Cleanup")
+	FOnTeamCleanupProgressChanged OnCleanupProgressChanged;
+
+private:
+	UFUNCTION()
+	void OnRep_CleanupProgress();
+
+	void ApplyItemTotalDelta(const UItemDefinitionDataAsset* ItemDefinition, int32 QuantityDelta);
+	void ApplyPlayerLoadDelta(int32 PlayerId, int32 QuantityDelta, float WeightDelta);
+	void RebuildItemTotalIndex();
+	void MarkCleanupProgressDirty();
+
+	UPROPERTY(ReplicatedUsing = OnRep_CleanupProgress)
+	FTeamCleanupProgress CleanupProgress;
+
+	TMap<TObjectKey<UItemDefinitionDataAsset>, int32> ItemTotalIndexByDefinition;
+};
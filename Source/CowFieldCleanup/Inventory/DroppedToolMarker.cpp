@@ -0,0 +1,64 @@
+#include "Inventory/DroppedToolMarker.h"
+
+#include "Components/SceneComponent.h"
+#include "Engine/World.h"
+#include "Inventory/DroppedToolRegistrySubsystem.h"
+#include "Net/UnrealNetwork.h"
+
+ADroppedToolMarker::ADroppedToolMarker()
+{
+	PrimaryActorTick.bCanEverTick = false;
+	bReplicates = true;
+	SetReplicatingMovement(false);
+	SetCanBeDamaged(false);
+
+	RootComponent = CreateDefaultSubobject<USceneComponent>(TEXT("Root"));
+}
+
+void ADroppedToolMarker::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
+{
+	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
+
+	DOREPLIFETIME(ADroppedToolMarker, TrackedTool); // Spatialized dropped tool record
+}
+
+void ADroppedToolMarker::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (!HasAuthority() && TrackedTool.ToolId.IsValid())
+	{
+		if (UDroppedToolRegistrySubsystem* ToolRegistry = GetWorld() ? GetWorld()->GetSubsystem<UDroppedToolRegistrySubsystem>() : nullptr)
+		{
+			UInventoryComponent* ReplicatingComponent = nullptr;
+			ToolRegistry->RemoveTool(TrackedTool.ToolId, ReplicatingComponent);
+		}
+	}
+
+	Super::EndPlay(EndPlayReason);
+}
+
+void ADroppedToolMarker::SetTrackedTool(const FTrackedTool& InTrackedTool)
+{
+	TrackedTool.ToolId = InTrackedTool.ToolId;
+	TrackedTool.OwnerPlayerId = InTrackedTool.OwnerPlayerId;
+	TrackedTool.WorldLocation = InTrackedTool.WorldLocation;
+	TrackedTool.bIsDropped = InTrackedTool.bIsDropped;
+	SetActorLocation(InTrackedTool.WorldLocation);
+}
+
+const FTrackedTool& ADroppedToolMarker::GetTrackedTool() const
+{
+	return TrackedTool;
+}
+
+void ADroppedToolMarker::OnRep_TrackedTool()
+{
+	if (!TrackedTool.ToolId.IsValid())
+	{
+		return;
+	}
+
+	if (UDroppedToolRegistrySubsystem* ToolRegistry = GetWorld() ? GetWorld()->GetSubsystem<UDroppedToolRegistrySubsystem>() : nullptr)
+	{
+		ToolRegistry->RegisterTool(TrackedTool, nullptr);
+	}
+}
@@ -0,0 +1,30 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/Actor.h"
+#include "Inventory/InventoryTypes.h"
+#include "DroppedToolMarker.generated.h"
+
+// Server-spawned proxy that carries one dropped tool record so the replication graph can
+// spatialize it; clients mirror received markers into their own dropped tool registry.
+UCLASS(NotBlueprintable, Transient)
+class COWFIELDCLEANUP_API ADroppedToolMarker : public AActor
+{
+	GENERATED_BODY()
+
+public:
+	ADroppedToolMarker();
+
+	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+	void SetTrackedTool(const FTrackedTool& InTrackedTool);
+	const FTrackedTool& GetTrackedTool() const;
+
+protected:
+	UFUNCTION()
+	void OnRep_TrackedTool();
+
+	UPROPERTY(ReplicatedUsing = OnRep_TrackedTool)
+	FTrackedTool TrackedTool;
+};
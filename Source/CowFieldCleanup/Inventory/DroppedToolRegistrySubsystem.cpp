@@ -0,0 +1,405 @@
+#include "Inventory/DroppedToolRegistrySubsystem.h"
+
+#include "Engine/World.h"
+#include "Inventory/DroppedToolMarker.h"
+#include "Inventory/InventoryComponent.h"
+#include "Inventory/InventoryStats.h"
+
+void UDroppedToolRegistrySubsystem::Deinitialize()
+{
+	for (const FToolRecord& Record : Records)
+	{
+		if (ADroppedToolMarker* Marker = Record.Marker.Get())
+		{
+			Marker->Destroy();
+		}
+	}
+
+	Records.Reset();
+	RecordIndexByToolId.Reset();
+	Cells.Reset();
+	RecordIndicesByOwner.Reset();
+
+	Super::Deinitialize();
+}
+
+void UDroppedToolRegistrySubsystem::ConfigureCellSize(float InCellSize)
+{
+	if (InCellSize <= 0.0f || FMath::IsNearlyEqual(InCellSize, CellSize))
+	{
+		return;
+	}
+
+	CellSize = InCellSize;
+	RebuildCells();
+}
+
+float UDroppedToolRegistrySubsystem::GetCellSize() const
+{
+	return CellSize;
+}
+
+UInventoryComponent* UDroppedToolRegistrySubsystem::RegisterTool(const FTrackedTool& TrackedTool, UInventoryComponent* ReplicatingComponent)
+{
+	LLM_SCOPE_BYTAG(Inventory);
+
+	++Revision;
+
+	if (const int32* ExistingIndex = RecordIndexByToolId.Find(TrackedTool.ToolId))
+	{
+		FToolRecord& Record = Records[*ExistingIndex];
+		UInventoryComponent* PreviousComponent = Record.ReplicatingComponent.Get();
+
+		const bool bCellChanged = GetCellForLocation(TrackedTool.WorldLocation) != Record.Cell;
+		const bool bOwnerChanged = TrackedTool.OwnerPlayerId != Record.TrackedTool.OwnerPlayerId;
+		if (bCellChanged)
+		{
+			RemoveFromCell(*ExistingIndex);
+		}
+		if (bOwnerChanged)
+		{
+			RemoveFromOwner(*ExistingIndex);
+		}
+
+		Record.TrackedTool.OwnerPlayerId = TrackedTool.OwnerPlayerId;
+		Record.TrackedTool.WorldLocation = TrackedTool.WorldLocation;
+		Record.TrackedTool.bIsDropped = TrackedTool.bIsDropped;
+		Record.ReplicatingComponent = ReplicatingComponent;
+
+		if (bCellChanged)
+		{
+			AddToCell(*ExistingIndex);
+		}
+		if (bOwnerChanged)
+		{
+			AddToOwner(*ExistingIndex);
+		}
+		SyncMarker(Record);
+
+		return PreviousComponent != ReplicatingComponent ? PreviousComponent : nullptr;
+	}
+
+	const int32 RecordIndex = Records.AddDefaulted();
+	FToolRecord& Record = Records[RecordIndex];
+	Record.TrackedTool.ToolId = TrackedTool.ToolId;
+	Record.TrackedTool.OwnerPlayerId = TrackedTool.OwnerPlayerId;
+	Record.TrackedTool.WorldLocation = TrackedTool.WorldLocation;
+	Record.TrackedTool.bIsDropped = TrackedTool.bIsDropped;
+	Record.ReplicatingComponent = ReplicatingComponent;
+
+	RecordIndexByToolId.Add(TrackedTool.ToolId, RecordIndex);
+	AddToCell(RecordIndex);
+	AddToOwner(RecordIndex);
+	SpawnMarker(Record);
+	return nullptr;
+}
+
+const FTrackedTool* UDroppedToolRegistrySubsystem::UpdateToolLocation(const FGuid& ToolId, const FVector& WorldLocation, UInventoryComponent*& OutReplicatingComponent)
+{
+	OutReplicatingComponent = nullptr;
+
+	const int32* RecordIndex = RecordIndexByToolId.Find(ToolId);
+	if (!RecordIndex)
+	{
+		return nullptr;
+	}
+
+	FToolRecord& Record = Records[*RecordIndex];
+	Record.TrackedTool.WorldLocation = WorldLocation;
+	Record.TrackedTool.bIsDropped = true;
+	++Revision;
+
+	const FIntPoint NewCell = GetCellForLocation(WorldLocation);
+	if (NewCell != Record.Cell)
+	{
+		RemoveFromCell(*RecordIndex);
+		AddToCell(*RecordIndex);
+	}
+
+	SyncMarker(Record);
+	OutReplicatingComponent = Record.ReplicatingComponent.Get();
+	return &Record.TrackedTool;
+}
+
+bool UDroppedToolRegistrySubsystem::RemoveTool(const FGuid& ToolId, UInventoryComponent*& OutReplicatingComponent)
+{
+	OutReplicatingComponent = nullptr;
+
+	int32 RecordIndex = INDEX_NONE;
+	if (!RecordIndexByToolId.RemoveAndCopyValue(ToolId, RecordIndex))
+	{
+		return false;
+	}
+
+	++Revision;
+	OutReplicatingComponent = Records[RecordIndex].ReplicatingComponent.Get();
+	RemoveFromCell(RecordIndex);
+	RemoveFromOwner(RecordIndex);
+
+	if (ADroppedToolMarker* Marker = Records[RecordIndex].Marker.Get())
+	{
+		Marker->Destroy();
+	}
+
+	const int32 LastIndex = Records.Num() - 1;
+	if (RecordIndex != LastIndex)
+	{
+		FToolRecord& MovedRecord = Records[LastIndex];
+		Cells.FindChecked(MovedRecord.Cell)[MovedRecord.IndexInCell] = RecordIndex;
+		RecordIndicesByOwner.FindChecked(MovedRecord.TrackedTool.OwnerPlayerId)[MovedRecord.IndexInOwner] = RecordIndex;
+		RecordIndexByToolId.FindChecked(MovedRecord.TrackedTool.ToolId) = RecordIndex;
+	}
+
+	Records.RemoveAtSwap(RecordIndex, 1, EAllowShrinking::No);
+	return true;
+}
+
+const FTrackedTool* UDroppedToolRegistrySubsystem::FindTool(const FGuid& ToolId) const
+{
+	const int32* RecordIndex = RecordIndexByToolId.Find(ToolId);
+	return RecordIndex ? &Records[*RecordIndex].TrackedTool : nullptr;
+}
+
+UInventoryComponent* UDroppedToolRegistrySubsystem::FindReplicatingComponent(const FGuid& ToolId) const
+{
+	const int32* RecordIndex = RecordIndexByToolId.Find(ToolId);
+	return RecordIndex ? Records[*RecordIndex].ReplicatingComponent.Get() : nullptr;
+}
+
+int32 UDroppedToolRegistrySubsystem::GetNumTools() const
+{
+	return Records.Num();
+}
+
+uint32 UDroppedToolRegistrySubsystem::GetRevision() const
+{
+	return Revision;
+}
+
+void UDroppedToolRegistrySubsystem::ForEachTool(TFunctionRef<void(const FTrackedTool&)> Visitor) const
+{
+	for (const FToolRecord& Record : Records)
+	{
+		Visitor(Record.TrackedTool);
+	}
+}
+
+void UDroppedToolRegistrySubsystem::ForEachToolInRadius(const FVector& Center, float Radius, TFunctionRef<void(const FTrackedTool&)> Visitor) const
+{
+	ForEachRecordInRadius(Center, Radius, [&Visitor](const FToolRecord& Record, double DistanceSquared)
+	{
+		Visitor(Record.TrackedTool);
+	});
+}
+
+void UDroppedToolRegistrySubsystem::ForEachMarkerInRadius(const FVector& Center, float Radius, TFunctionRef<void(ADroppedToolMarker&, double DistanceSquared)> Visitor) const
+{
+	ForEachRecordInRadius(Center, Radius, [&Visitor](const FToolRecord& Record, double DistanceSquared)
+	{
+		if (ADroppedToolMarker* Marker = Record.Marker.Get())
+		{
+			Visitor(*Marker, DistanceSquared);
+		}
+	});
+}
+
+void UDroppedToolRegistrySubsystem::FindNearestToolsForOwner(int32 OwnerPlayerId, const FVector& Center, int32 MaxResults, TArray<FNearestTool>& OutNearest) const
+{
+	OutNearest.Reset();
+
+	const TArray<int32>* OwnerRecords = RecordIndicesByOwner.Find(OwnerPlayerId);
+	if (!OwnerRecords || MaxResults <= 0)
+	{
+		return;
+	}
+
+	// Max-heap on distance capped at MaxResults, so the farthest kept candidate is always at the top.
+	const auto FarthestFirst = [](const FNearestTool& A, const FNearestTool& B)
+	{
+		return A.DistanceSquared > B.DistanceSquared;
+	};
+
+	for (const int32 RecordIndex : *OwnerRecords)
+	{
+		const FTrackedTool& TrackedTool = Records[RecordIndex].TrackedTool;
+		if (!TrackedTool.bIsDropped)
+		{
+			continue;
+		}
+
+		const double DistanceSquared = FVector::DistSquared(TrackedTool.WorldLocation, Center);
+		if (OutNearest.Num() < MaxResults)
+		{
+			OutNearest.HeapPush(FNearestTool{ &TrackedTool, DistanceSquared }, FarthestFirst);
+		}
+		else if (DistanceSquared < OutNearest.HeapTop().DistanceSquared)
+		{
+			OutNearest.HeapPopDiscard(FarthestFirst, EAllowShrinking::No);
+			OutNearest.HeapPush(FNearestTool{ &TrackedTool, DistanceSquared }, FarthestFirst);
+		}
+	}
+
+	OutNearest.Sort([](const FNearestTool& A, const FNearestTool& B)
+	{
+		return A.DistanceSquared < B.DistanceSquared;
+	});
+}
+
+FIntPoint UDroppedToolRegistrySubsystem::GetCellForLocation(const FVector& WorldLocation) const
+{
+	return FIntPoint(
+		FMath::FloorToInt32(WorldLocation.X / CellSize),
+		FMath::FloorToInt32(WorldLocation.Y / CellSize));
+}
+
+void UDroppedToolRegistrySubsystem::AddToCell(int32 RecordIndex)
+{
+	LLM_SCOPE_BYTAG(Inventory);
+
+	FToolRecord& Record = Records[RecordIndex];
+	Record.Cell = GetCellForLocation(Record.TrackedTool.WorldLocation);
+
+	TArray<int32>& CellRecords = Cells.FindOrAdd(Record.Cell);
+	Record.IndexInCell = CellRecords.Add(RecordIndex);
+}
+
+void UDroppedToolRegistrySubsystem::RemoveFromCell(int32 RecordIndex)
+{
+	FToolRecord& Record = Records[RecordIndex];
+	TArray<int32>* CellRecords = Cells.Find(Record.Cell);
+	if (!CellRecords || Record.IndexInCell == INDEX_NONE)
+	{
+		return;
+	}
+
+	const int32 LastIndexInCell = CellRecords->Num() - 1;
+	if (Record.IndexInCell != LastIndexInCell)
+	{
+		const int32 MovedRecordIndex = (*CellRecords)[LastIndexInCell];
+		Records[MovedRecordIndex].IndexInCell = Record.IndexInCell;
+	}
+
+	CellRecords->RemoveAtSwap(Record.IndexInCell, 1, EAllowShrinking::No);
+	if (CellRecords->IsEmpty())
+	{
+		Cells.Remove(Record.Cell);
+	}
+
+	Record.IndexInCell = INDEX_NONE;
+}
+
+void UDroppedToolRegistrySubsystem::RebuildCells()
+{
+	Cells.Reset();
+	for (int32 RecordIndex = 0; RecordIndex < Records.Num(); ++RecordIndex)
+	{
+		AddToCell(RecordIndex);
+	}
+}
+
+void UDroppedToolRegistrySubsystem::ForEachRecordInRadius(const FVector& Center, float Radius, TFunctionRef<void(const FToolRecord&, double DistanceSquared)> Visitor) const
+{
+	if (Radius < 0.0f)
+	{
+		return;
+	}
+
+	const FIntPoint MinCell = GetCellForLocation(Center - FVector(Radius, Radius, 0.0f));
+	const FIntPoint MaxCell = GetCellForLocation(Center + FVector(Radius, Radius, 0.0f));
+	const double RadiusSquared = FMath::Square(static_cast<double>(Radius));
+
+	for (int32 CellX = MinCell.X; CellX <= MaxCell.X; ++CellX)
+	{
+		for (int32 CellY = MinCell.Y; CellY <= MaxCell.Y; ++CellY)
+		{
+			const TArray<int32>* CellRecords = Cells.Find(FIntPoint(CellX, CellY));
+			if (!CellRecords)
+			{
+				continue;
+			}
+
+			for (const int32 RecordIndex : *CellRecords)
+			{
+				const FToolRecord& Record = Records[RecordIndex];
+				const double DistanceSquared = FVector::DistSquared(Record.TrackedTool.WorldLocation, Center);
+				if (DistanceSquared <= RadiusSquared)
+				{
+					Visitor(Record, DistanceSquared);
+				}
+			}
+		}
+	}
+}
+
+void UDroppedToolRegistrySubsystem::AddToOwner(int32 RecordIndex)
+{
+	LLM_SCOPE_BYTAG(Inventory);
+
+	FToolRecord& Record = Records[RecordIndex];
+	TArray<int32>& OwnerRecords = RecordIndicesByOwner.FindOrAdd(Record.TrackedTool.OwnerPlayerId);
+	Record.IndexInOwner = OwnerRecords.Add(RecordIndex);
+}
+
+void UDroppedToolRegistrySubsystem::RemoveFromOwner(int32 RecordIndex)
+{
+	FToolRecord& Record = Records[RecordIndex];
+	TArray<int32>* OwnerRecords = RecordIndicesByOwner.Find(Record.TrackedTool.OwnerPlayerId);
+	if (!OwnerRecords || Record.IndexInOwner == INDEX_NONE)
+	{
+		return;
+	}
+
+	const int32 LastIndexInOwner = OwnerRecords->Num() - 1;
+	if (Record.IndexInOwner != LastIndexInOwner)
+	{
+		const int32 MovedRecordIndex = (*OwnerRecords)[LastIndexInOwner];
+		Records[MovedRecordIndex].IndexInOwner = Record.IndexInOwner;
+	}
+
+	OwnerRecords->RemoveAtSwap(Record.IndexInOwner, 1, EAllowShrinking::No);
+	if (OwnerRecords->IsEmpty())
+	{
+		RecordIndicesByOwner.Remove(Record.TrackedTool.OwnerPlayerId);
+	}
+
+	Record.IndexInOwner = INDEX_NONE;
+}
+
+bool UDroppedToolRegistrySubsystem::ShouldSpawnMarkers() const
+{
+	const UWorld* World = GetWorld();
+	if (!World)
+	{
+		return false;
+	}
+
+	const ENetMode NetMode = World->GetNetMode();
+	return NetMode == NM_ListenServer || NetMode == NM_DedicatedServer;
+}
+
+void UDroppedToolRegistrySubsystem::SpawnMarker(FToolRecord& Record)
+{
+	if (!ShouldSpawnMarkers())
+	{
+		return;
+	}
+
+	FActorSpawnParameters SpawnParameters;
+	SpawnParameters.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+	SpawnParameters.ObjectFlags |= RF_Transient;
+
+	ADroppedToolMarker* Marker = GetWorld()->SpawnActor<ADroppedToolMarker>(Record.TrackedTool.WorldLocation, FRotator::ZeroRotator, SpawnParameters);
+	if (Marker)
+	{
+		Marker->SetTrackedTool(Record.TrackedTool);
+		Record.Marker = Marker;
+	}
+}
+
+void UDroppedToolRegistrySubsystem::SyncMarker(const FToolRecord& Record)
+{
+	if (ADroppedToolMarker* Marker = Record.Marker.Get())
+	{
+		Marker->SetTrackedTool(Record.TrackedTool);
+	}
+}
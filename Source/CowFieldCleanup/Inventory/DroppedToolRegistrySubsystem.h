@@ -0,0 +1,76 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Inventory/InventoryTypes.h"
+#include "DroppedToolRegistrySubsystem.generated.h"
+
+class ADroppedToolMarker;
+class UInventoryComponent;
+
+UCLASS()
+class COWFIELDCLEANUP_API UDroppedToolRegistrySubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	struct FNearestTool
+	{
+		const FTrackedTool* TrackedTool = nullptr;
+		double DistanceSquared = 0.0;
+	};
+
+	virtual void Deinitialize() override;
+
+	void ConfigureCellSize(float InCellSize);
+	float GetCellSize() const;
+
+	UInventoryComponent* RegisterTool(const FTrackedTool& TrackedTool, UInventoryComponent* ReplicatingComponent);
+	const FTrackedTool* UpdateToolLocation(const FGuid& ToolId, const FVector& WorldLocation, UInventoryComponent*& OutReplicatingComponent);
+	bool RemoveTool(const FGuid& ToolId, UInventoryComponent*& OutReplicatingComponent);
+
+	const FTrackedTool* FindTool(const FGuid& ToolId) const;
+	UInventoryComponent* FindReplicatingComponent(const FGuid& ToolId) const;
+	int32 GetNumTools() const;
+
+	// Bumped on every register, move and removal so readers can tell when cached tool data went stale.
+	uint32 GetRevision() const;
+
+	void ForEachTool(TFunctionRef<void(const FTrackedTool&)> Visitor) const;
+
+	void ForEachToolInRadius(const FVector& Center, float Radius, TFunctionRef<void(const FTrackedTool&)> Visitor) const;
+	void ForEachMarkerInRadius(const FVector& Center, float Radius, TFunctionRef<void(ADroppedToolMarker&, double DistanceSquared)> Visitor) const;
+
+	// Up to MaxResults of the owner's dropped tools, nearest first. Only that owner's records are visited.
+	void FindNearestToolsForOwner(int32 OwnerPlayerId, const FVector& Center, int32 MaxResults, TArray<FNearestTool>& OutNearest) const;
+
+private:
+	struct FToolRecord
+	{
+		FTrackedTool TrackedTool;
+		TWeakObjectPtr<UInventoryComponent> ReplicatingComponent;
+		TWeakObjectPtr<ADroppedToolMarker> Marker;
+		FIntPoint Cell = FIntPoint::ZeroValue;
+		int32 IndexInCell = INDEX_NONE;
+		int32 IndexInOwner = INDEX_NONE;
+	};
+
+	FIntPoint GetCellForLocation(const FVector& WorldLocation) const;
+	void AddToCell(int32 RecordIndex);
+	void RemoveFromCell(int32 RecordIndex);
+	void RebuildCells();
+	void AddToOwner(int32 RecordIndex);
+	void RemoveFromOwner(int32 RecordIndex);
+	void ForEachRecordInRadius(const FVector& Center, float Radius, TFunctionRef<void(const FToolRecord&, double DistanceSquared)> Visitor) const;
+
+	bool ShouldSpawnMarkers() const;
+	void SpawnMarker(FToolRecord& Record);
+	void SyncMarker(const FToolRecord& Record);
+
+	TArray<FToolRecord> Records;
+	TMap<FGuid, int32> RecordIndexByToolId;
+	TMap<FIntPoint, TArray<int32>> Cells;
+	TMap<int32, TArray<int32>> RecordIndicesByOwner;
+	float CellSize = 5000.0f;
+	uint32 Revision = 0;
+};
@@ -0,0 +1,141 @@
+#include "Inventory/InventoryAssetPreloadSubsystem.h"
+
+#include "CowFieldCleanup.h"
+#include "DataAssets/InventoryBalanceDataAsset.h"
+#include "DataAssets/ItemDefinitionDataAsset.h"
+#include "Engine/AssetManager.h"
+#include "Engine/StreamableManager.h"
+#include "Engine/World.h"
+#include "Settings/InventoryAssetSettings.h"
+#include "UObject/UObjectGlobals.h"
+
+void UInventoryAssetPreloadSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	RegisterPrimaryAssetTypes();
+
+	if (GetDefault<UInventoryAssetSettings>()->bPreloadOnMapLoad)
+	{
+		PostLoadMapHandle = FCoreUObjectDelegates::PostLoadMapWithWorld.AddUObject(this, &UInventoryAssetPreloadSubsystem::HandlePostLoadMap);
+	}
+}
+
+void UInventoryAssetPreloadSubsystem::Deinitialize()
+{
+	FCoreUObjectDelegates::PostLoadMapWithWorld.Remove(PostLoadMapHandle);
+
+	if (PreloadHandle.IsValid())
+	{
+		PreloadHandle->CancelHandle();
+		PreloadHandle.Reset();
+	}
+
+	PendingCallbacks.Reset();
+
+	Super::Deinitialize();
+}
+
+void UInventoryAssetPreloadSubsystem::BeginPreload()
+{
+	if (PreloadHandle.IsValid() || !UAssetManager::IsInitialized())
+	{
+		return;
+	}
+
+	UAssetManager& AssetManager = UAssetManager::Get();
+
+	TArray<FPrimaryAssetId> AssetIds;
+	AssetManager.GetPrimaryAssetIdList(UItemDefinitionDataAsset::PrimaryAssetType, AssetIds);
+
+	TArray<FPrimaryAssetId> BalanceIds;
+	AssetManager.GetPrimaryAssetIdList(UInventoryBalanceDataAsset::PrimaryAssetType, BalanceIds);
+	AssetIds.Append(BalanceIds);
+
+	PreloadHandle = AssetManager.LoadPrimaryAssets(
+		AssetIds,
+		GetDefault<UInventoryAssetSettings>()->PreloadBundles,
+		FStreamableDelegate::CreateUObject(this, &UInventoryAssetPreloadSubsystem::HandlePreloadCompleted));
+
+	if (!PreloadHandle.IsValid())
+	{
+		HandlePreloadCompleted();
+	}
+}
+
+bool UInventoryAssetPreloadSubsystem::IsPreloadComplete() const
+{
+	return bPreloadComplete;
+}
+
+void UInventoryAssetPreloadSubsystem::CallWhenPreloaded(FSimpleDelegate Callback)
+{
+	if (bPreloadComplete)
+	{
+		Callback.ExecuteIfBound();
+		return;
+	}
+
+	PendingCallbacks.Add(MoveTemp(Callback));
+	BeginPreload();
+}
+
+void UInventoryAssetPreloadSubsystem::RegisterPrimaryAssetTypes() const
+{
+	if (!UAssetManager::IsInitialized())
+	{
+		return;
+	}
+
+	UAssetManager& AssetManager = UAssetManager::Get();
+	const UInventoryAssetSettings* Settings = GetDefault<UInventoryAssetSettings>();
+
+	auto RegisterType = [&AssetManager](const FPrimaryAssetType& AssetType, const TArray<FDirectoryPath>& Directories, UClass* BaseClass)
+	{
+		FPrimaryAssetTypeInfo ExistingInfo;
+		if (Directories.IsEmpty() || AssetManager.GetPrimaryAssetTypeInfo(AssetType, ExistingInfo))
+		{
+			return;
+		}
+
+		TArray<FString> Paths;
+		for (const FDirectoryPath& Directory : Directories)
+		{
+			Paths.Add(Directory.Path);
+		}
+
+		UE_LOG(LogCowFieldCleanup, Warning, TEXT("Primary asset type %s is not in the asset manager settings; scanning at runtime, so it will not be cooked."), *AssetType.ToString());
+
+		AssetManager.ScanPathsForPrimaryAssets(AssetType, Paths, BaseClass, false);
+	};
+
+	RegisterType(UItemDefinitionDataAsset::PrimaryAssetType, Settings->ItemDefinitionDirectories, UItemDefinitionDataAsset::StaticClass());
+	RegisterType(UInventoryBalanceDataAsset::PrimaryAssetType, Settings->BalanceDataDirectories, UInventoryBalanceDataAsset::StaticClass());
+}
+
+void UInventoryAssetPreloadSubsystem::HandlePostLoadMap(UWorld* LoadedWorld)
+{
+	if (LoadedWorld && LoadedWorld->GetGameInstance() == GetGameInstance())
+	{
+		BeginPreload();
+	}
+}
+
+void UInventoryAssetPreloadSubsystem::HandlePreloadCompleted()
+{
+	if (bPreloadComplete)
+	{
+		return;
+	}
+
+	bPreloadComplete = true;
+	UE_LOG(LogCowFieldCleanup, Log, TEXT("Inventory assets preloaded."));
+
+	TArray<FSimpleDelegate> Callbacks = MoveTemp(PendingCallbacks);
+	for (FSimpleDelegate& Callback : Callbacks)
+	{
+		Callback.ExecuteIfBound();
+	}
+
+	OnInventoryAssetsPreloaded.Broadcast();
+}
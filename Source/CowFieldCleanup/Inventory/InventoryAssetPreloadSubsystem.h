@@ -0,0 +1,41 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/GameInstanceSubsystem.h"
+#include "InventoryAssetPreloadSubsystem.generated.h"
+
+struct FStreamableHandle;
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE(FOnInventoryAssetsPreloaded);
+
+UCLASS()
+class COWFIELDCLEANUP_API UInventoryAssetPreloadSubsystem : public UGameInstanceSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+
+	UFUNCTION(BlueprintCallable, Category = "Inventory|Assets")
+	void BeginPreload();
+
+	UFUNCTION(BlueprintPure, Category = "Inventory|Assets")
+	bool IsPreloadComplete() const;
+
+	void CallWhenPreloaded(FSimpleDelegate Callback);
+
+	UPROPERTY(BlueprintAssignable, Category = "Inventory|Assets")
+	FOnInventoryAssetsPreloaded OnInventoryAssetsPreloaded;
+
+private:
+	// Fallback for types missing from PrimaryAssetTypesToScan in DefaultGame.ini; assets found here are not cooked.
+	void RegisterPrimaryAssetTypes() const;
+	void HandlePostLoadMap(UWorld* LoadedWorld);
+	void HandlePreloadCompleted();
+
+	TSharedPtr<FStreamableHandle> PreloadHandle;
+	TArray<FSimpleDelegate> PendingCallbacks;
+	FDelegateHandle PostLoadMapHandle;
+	bool bPreloadComplete = false;
+};
@@ -2,60 +2,274 @@
 
 #include "DataAssets/InventoryBalanceDataAsset.h"
 #include "DataAssets/ItemDefinitionDataAsset.h"
+#include "Engine/GameInstance.h"
+#include "Engine/World.h"
+#include "Game/CowFieldCleanupGameState.h"
 #include "GameFramework/Actor.h"
+#include "GameFramework/Pawn.h"
 #include "GameFramework/PlayerState.h"
+#include "Algo/BinarySearch.h"
+#include "Components/PrimitiveComponent.h"
+#include "CowFieldCleanup.h"
+#include "Engine/NetConnection.h"
+#include "Inventory/DroppedToolRegistrySubsystem.h"
+#include "Inventory/InventoryEventLogSubsystem.h"
+#include "Inventory/InventorySnapshot.h"
+#include "Inventory/InventoryRpcRateLimitSubsystem.h"
+#include "Inventory/InventoryStats.h"
+#include "Inventory/InventoryTravelSubsystem.h"
+#include "Inventory/ItemDefinitionRegistry.h"
+#include "Inventory/ToolLocatorTrackingSubsystem.h"
+#include "Litter/LitterField.h"
+#include "Net/Core/PushModel/PushModel.h"
 #include "Net/UnrealNetwork.h"
+#include "TimerManager.h"
+
+DECLARE_CYCLE_STAT(TEXT("Tick"), STAT_InventoryTick, STATGROUP_Inventory);
+DECLARE_CYCLE_STAT(TEXT("ServerAddToolToSlot"), STAT_InventoryServerAddToolToSlot, STATGROUP_Inventory);
+DECLARE_CYCLE_STAT(TEXT("ServerRemoveToolFromSlot"), STAT_InventoryServerRemoveToolFromSlot, STATGROUP_Inventory);
+DECLARE_CYCLE_STAT(TEXT("ServerAddBagItem"), STAT_InventoryServerAddBagItem, STATGROUP_Inventory);
+DECLARE_CYCLE_STAT(TEXT("ServerRemoveBagItem"), STAT_InventoryServerRemoveBagItem, STATGROUP_Inventory);
+DECLARE_CYCLE_STAT(TEXT("ServerPickupLitter"), STAT_InventoryServerPickupLitter, STATGROUP_Inventory);
+DECLARE_CYCLE_STAT(TEXT("ClientBagItemRefused"), STAT_InventoryClientBagItemRefused, STATGROUP_Inventory);
+DECLARE_CYCLE_STAT(TEXT("ServerApplyInventoryBatch"), STAT_InventoryServerApplyInventoryBatch, STATGROUP_Inventory);
+DECLARE_CYCLE_STAT(TEXT("ServerRegisterDroppedTool"), STAT_InventoryServerRegisterDroppedTool, STATGROUP_Inventory);
+DECLARE_CYCLE_STAT(TEXT("ServerUpdateDroppedToolLocation"), STAT_InventoryServerUpdateDroppedToolLocation, STATGROUP_Inventory);
+DECLARE_CYCLE_STAT(TEXT("ServerStreamDroppedToolLocation"), STAT_InventoryServerStreamDroppedToolLocation, STATGROUP_Inventory);
+DECLARE_CYCLE_STAT(TEXT("ServerRemoveDroppedTool"), STAT_InventoryServerRemoveDroppedTool, STATGROUP_Inventory);
+DECLARE_CYCLE_STAT(TEXT("ServerRequestLocateTool"), STAT_InventoryServerRequestLocateTool, STATGROUP_Inventory);
+DECLARE_CYCLE_STAT(TEXT("ClientReceiveToolLocation"), STAT_InventoryClientReceiveToolLocation, STATGROUP_Inventory);
+DECLARE_CYCLE_STAT(TEXT("ServerRequestLocateAllTools"), STAT_InventoryServerRequestLocateAllTools, STATGROUP_Inventory);
+DECLARE_CYCLE_STAT(TEXT("ClientReceiveToolLocations"), STAT_InventoryClientReceiveToolLocations, STATGROUP_Inventory);
+DECLARE_CYCLE_STAT(TEXT("ServerStartLocatorTracking"), STAT_InventoryServerStartLocatorTracking, STATGROUP_Inventory);
+DECLARE_CYCLE_STAT(TEXT("ServerStopLocatorTracking"), STAT_InventoryServerStopLocatorTracking, STATGROUP_Inventory);
+DECLARE_CYCLE_STAT(TEXT("ClientReceiveLocatorTracking"), STAT_InventoryClientReceiveLocatorTracking, STATGROUP_Inventory);
+DECLARE_CYCLE_STAT(TEXT("OnRep_ToolSlots"), STAT_InventoryOnRepToolSlots, STATGROUP_Inventory);
+DECLARE_CYCLE_STAT(TEXT("OnRep_BagEntries"), STAT_InventoryOnRepBagEntries, STATGROUP_Inventory);
+DECLARE_CYCLE_STAT(TEXT("OnRep_BagTotalWeight"), STAT_InventoryOnRepBagTotalWeight, STATGROUP_Inventory);
+DECLARE_CYCLE_STAT(TEXT("OnRep_TrackedTools"), STAT_InventoryOnRepTrackedTools, STATGROUP_Inventory);
+DECLARE_CYCLE_STAT(TEXT("OnRep_LastProcessedBatchSequence"), STAT_InventoryOnRepLastProcessedBatchSequence, STATGROUP_Inventory);
+DECLARE_CYCLE_STAT(TEXT("RecalculateBagWeight"), STAT_InventoryRecalculateBagWeight, STATGROUP_Inventory);
+DECLARE_CYCLE_STAT(TEXT("ResolveDistanceBand"), STAT_InventoryResolveDistanceBand, STATGROUP_Inventory);
+
+namespace InventoryComponentValidation
+{
+	// Failing an RPC's _Validate disconnects the client, so only reject values an honest client cannot send.
+	static bool IsValidWorldLocation(const FVector& WorldLocation)
+	{
+		return !WorldLocation.ContainsNaN() && WorldLocation.GetAbsMax() <= UE_LARGE_HALF_WORLD_MAX;
+	}
+}
+
+namespace InventoryComponentStats
+{
+	// Host-local RPCs execute in place and never cross the wire, so they are not counted.
+	static bool IsRemoteInventoryRpc(const AActor* OwnerActor)
+	{
+		return OwnerActor && OwnerActor->GetNetMode() != NM_Standalone && !(OwnerActor->HasAuthority() && OwnerActor->HasLocalNetOwner());
+	}
+}
 
 UInventoryComponent::UInventoryComponent()
 {
-	PrimaryComponentTick.bCanEverTick = false;
+	PrimaryComponentTick.bCanEverTick = true;
+	PrimaryComponentTick.bStartWithTickEnabled = false;
+	PrimaryComponentTick.TickGroup = TG_PostUpdateWork;
 	SetIsReplicatedByDefault(true);
+
+	BagEntries.OwnerComponent = this;
+	TrackedTools.OwnerComponent = this;
 }
 
 void UInventoryComponent::BeginPlay()
 {
 	Super::BeginPlay();
 
+	InventoryStats::RegisterComponent();
+	RefreshBalanceProfile();
+
+#if WITH_EDITOR
+	if (BalanceData)
+	{
+		BalanceProfileRebuiltHandle = BalanceData->OnCompiledProfileRebuilt.AddUObject(this, &UInventoryComponent::RefreshBalanceProfile);
+	}
+#endif
+
 	if (GetOwner()->HasAuthority())
 	{
+		LLM_SCOPE_BYTAG(Inventory);
 		InitializeToolSlots();
 		RecalculateBagWeight();
+
+		if (UDroppedToolRegistrySubsystem* ToolRegistry = GetToolRegistry())
+		{
+			ToolRegistry->ConfigureCellSize(GetMediumDistance());
+		}
+
+		TryRestoreTravelSnapshot();
+	}
+}
+
+void UInventoryComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+#if WITH_EDITOR
+	if (BalanceData)
+	{
+		BalanceData->OnCompiledProfileRebuilt.Remove(BalanceProfileRebuiltHandle);
+	}
+	BalanceProfileRebuiltHandle.Reset();
+#endif
+
+	for (const TPair<FGuid, FDroppedToolStream>& StreamPair : DroppedToolStreams)
+	{
+		if (UPrimitiveComponent* Body = StreamPair.Value.Body.Get())
+		{
+			Body->OnComponentWake.RemoveDynamic(this, &UInventoryComponent::HandleDroppedToolBodyWake);
+			Body->OnComponentSleep.RemoveDynamic(this, &UInventoryComponent::HandleDroppedToolBodySleep);
+		}
+	}
+	DroppedToolStreams.Reset();
+
+	if (UWorld* World = GetWorld())
+	{
+		World->GetTimerManager().ClearTimer(IdleDormancyTimerHandle);
+	}
+
+	if (UToolLocatorTrackingSubsystem* LocatorTracking = CanModifyInventory() ? GetLocatorTracking() : nullptr)
+	{
+		LocatorTracking->Unsubscribe(this);
+	}
+
+	// The bag leaves the match with its owner, so take its contents back out of the team totals.
+	if (CanModifyInventory())
+	{
+		for (const FBagItemEntry& Entry : BagEntries.Items)
+		{
+			PushTeamProgressDelta(Entry.ItemDefinition, -Entry.Quantity);
+		}
+	}
+
+	if (EndPlayReason == EEndPlayReason::LevelTransition && CanModifyInventory())
+	{
+		const UGameInstance* GameInstance = GetWorld() ? GetWorld()->GetGameInstance() : nullptr;
+		if (UInventoryTravelSubsystem* TravelSubsystem = GameInstance ? GameInstance->GetSubsystem<UInventoryTravelSubsystem>() : nullptr)
+		{
+			TravelSubsystem->CaptureInventory(*this);
+		}
+	}
+
+	if (APawn* OwnerPawn = Cast<APawn>(GetOwner()))
+	{
+		OwnerPawn->ReceiveControllerChangedDelegate.RemoveDynamic(this, &UInventoryComponent::HandleOwnerControllerChanged);
+	}
+
+	InventoryStats::UnregisterComponent();
+	Super::EndPlay(EndPlayReason);
+}
+
+void UInventoryComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
+{
+	INVENTORY_SCOPE_CYCLE_COUNTER(STAT_InventoryTick);
+
+	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+
+	if (!PendingBatchOps.IsEmpty())
+	{
+		FlushInventoryBatch();
+	}
+
+	if (bReconcilePending)
+	{
+		ReconcilePredictedOps();
+	}
+
+	StreamAwakeDroppedToolBodies();
+
+	if (PendingChangeMask != EInventoryChangeFlags::None)
+	{
+		DispatchInventoryChanges();
 	}
+
+	// Handlers run during dispatch may queue more changes, batch ops or a reconcile; keep ticking until they drain.
+	const bool bHasPendingWork = PendingChangeMask != EInventoryChangeFlags::None || !PendingBatchOps.IsEmpty() || bReconcilePending;
+	SetComponentTickEnabled(bHasPendingWork || HasAwakeDroppedToolBodies());
 }
 
 void UInventoryComponent::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
 {
 	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
 
-	DOREPLIFETIME(UInventoryComponent, ToolSlots); // Replicated tool slot state
-	DOREPLIFETIME(UInventoryComponent, BagEntries); // Replicated cleanup bag contents
-	DOREPLIFETIME(UInventoryComponent, BagTotalWeight); // Replicated bag weight
-	DOREPLIFETIME(UInventoryComponent, TrackedTools); // Replicated dropped tool tracking
+	FDoRepLifetimeParams SharedParams;
+	SharedParams.bIsPushBased = true;
+
+	FDoRepLifetimeParams OwnerOnlyParams;
+	OwnerOnlyParams.bIsPushBased = true;
+	OwnerOnlyParams.Condition = COND_OwnerOnly;
+
+	DOREPLIFETIME_WITH_PARAMS_FAST(UInventoryComponent, ToolSlots, SharedParams); // Replicated tool slot state
+	DOREPLIFETIME_WITH_PARAMS_FAST(UInventoryComponent, BagEntries, OwnerOnlyParams); // Cleanup bag contents, only the owner's UI reads them
+	DOREPLIFETIME_WITH_PARAMS_FAST(UInventoryComponent, BagTotalWeight, SharedParams); // Replicated bag weight
+	DOREPLIFETIME_WITH_PARAMS_FAST(UInventoryComponent, TrackedTools, OwnerOnlyParams); // Owned dropped tools; nearby ones arrive via ADroppedToolMarker
+	DOREPLIFETIME_WITH_PARAMS_FAST(UInventoryComponent, LastProcessedBatchSequence, OwnerOnlyParams); // Acked client batch for prediction
 }
 
 const TArray<FToolSlotEntry>& UInventoryComponent::GetToolSlots() const
 {
-	return ToolSlots;
+	return bHasPredictedView ? PredictedToolSlots : ToolSlots;
 }
 
 const TArray<FBagItemEntry>& UInventoryComponent::GetBagEntries() const
 {
-	return BagEntries;
+	return bHasPredictedView ? PredictedBagEntries : BagEntries.Items;
 }
 
 float UInventoryComponent::GetBagTotalWeight() const
 {
-	return BagTotalWeight;
+	return bHasPredictedView ? PredictedBagWeight : BagTotalWeight;
 }
 
 float UInventoryComponent::GetMovementSpeedMultiplier() const
 {
-	return GetCurveValueSafe(BalanceData ? BalanceData->MovementSpeedByWeight : nullptr);
+	return CachedMovementSpeedMultiplier;
 }
 
 float UInventoryComponent::GetStaminaDrainMultiplier() const
 {
-	return GetCurveValueSafe(BalanceData ? BalanceData->StaminaDrainMultiplierByWeight : nullptr);
+	return CachedStaminaDrainMultiplier;
+}
+
+void UInventoryComponent::SetBalanceData(UInventoryBalanceDataAsset* InBalanceData)
+{
+#if WITH_EDITOR
+	if (BalanceData)
+	{
+		BalanceData->OnCompiledProfileRebuilt.Remove(BalanceProfileRebuiltHandle);
+	}
+	BalanceProfileRebuiltHandle.Reset();
+
+	if (InBalanceData && HasBegunPlay())
+	{
+		BalanceProfileRebuiltHandle = InBalanceData->OnCompiledProfileRebuilt.AddUObject(this, &UInventoryComponent::RefreshBalanceProfile);
+	}
+#endif
+
+	BalanceData = InBalanceData;
+	RefreshBalanceProfile();
+}
+
+uint64 UInventoryComponent::GetEstimatedReplicatedBytes() const
+{
+	return EstimatedReplicatedBytes;
+}
+
+void UInventoryComponent::SaveSnapshot(TArray<uint8>& OutBytes) const
+{
+	FInventorySnapshot::Save(*this, OutBytes);
+}
+
+bool UInventoryComponent::LoadSnapshot(TConstArrayView<uint8> Bytes)
+{
+	return FInventorySnapshot::Load(*this, Bytes);
 }
 
 void UInventoryComponent::RequestAddToolToSlot(UItemDefinitionDataAsset* ItemDefinition, const FGuid& ToolId, int32 SlotIndex)
@@ -71,7 +285,7 @@ void UInventoryComponent::RequestAddToolToSlot(UItemDefinitionDataAsset* ItemDef
 		return;
 	}
 
-	ServerAddToolToSlot(ItemDefinition, ToolId, SlotIndex);
+	QueueBatchOp(EInventoryBatchOpType::AddToolToSlot, ItemDefinition, ToolId, SlotIndex);
 }
 
 void UInventoryComponent::RequestRemoveToolFromSlot(int32 SlotIndex)
@@ -82,7 +296,7 @@ void UInventoryComponent::RequestRemoveToolFromSlot(int32 SlotIndex)
 		return;
 	}
 
-	ServerRemoveToolFromSlot(SlotIndex);
+	QueueBatchOp(EInventoryBatchOpType::RemoveToolFromSlot, nullptr, FGuid(), SlotIndex);
 }
 
 void UInventoryComponent::RequestAddBagItem(UItemDefinitionDataAsset* ItemDefinition, int32 Quantity)
@@ -98,7 +312,7 @@ void UInventoryComponent::RequestAddBagItem(UItemDefinitionDataAsset* ItemDefini
 		return;
 	}
 
-	ServerAddBagItem(ItemDefinition, Quantity);
+	QueueBatchOp(EInventoryBatchOpType::AddBagItem, ItemDefinition, FGuid(), Quantity);
 }
 
 void UInventoryComponent::RequestRemoveBagItem(UItemDefinitionDataAsset* ItemDefinition, int32 Quantity)
@@ -114,374 +328,1584 @@ void UInventoryComponent::RequestRemoveBagItem(UItemDefinitionDataAsset* ItemDef
 		return;
 	}
 
-	ServerRemoveBagItem(ItemDefinition, Quantity);
+	QueueBatchOp(EInventoryBatchOpType::RemoveBagItem, ItemDefinition, FGuid(), Quantity);
 }
 
-void UInventoryComponent::RequestLocateTool(const FGuid& ToolId)
+void UInventoryComponent::RequestPickupLitter(ALitterField* LitterField, int32 LitterIndex)
 {
+	if (!LitterField || LitterIndex < 0)
+	{
+		return;
+	}
+
 	if (GetOwner()->HasAuthority())
 	{
-		ServerRequestLocateTool(ToolId);
+		ServerPickupLitter(LitterField, LitterIndex);
 		return;
 	}
 
-	ServerRequestLocateTool(ToolId);
+	ServerPickupLitter(LitterField, LitterIndex);
+	RecordReliableRpcSent();
 }
 
-void UInventoryComponent::RegisterDroppedTool(const FGuid& ToolId, int32 OwnerPlayerId, const FVector& WorldLocation)
+void UInventoryComponent::FlushInventoryBatch()
 {
-	if (GetOwner()->HasAuthority())
+	for (int32 FirstOp = 0; FirstOp < PendingBatchOps.Num(); FirstOp += MaxInventoryBatchOps)
 	{
-		ServerRegisterDroppedTool(ToolId, OwnerPlayerId, WorldLocation);
-		return;
+		const int32 NumOps = FMath::Min(MaxInventoryBatchOps, PendingBatchOps.Num() - FirstOp);
+		const uint32 BatchSequence = LastSentBatchSequence + FirstOp + NumOps;
+		ServerApplyInventoryBatch(TArray<FInventoryBatchOp>(PendingBatchOps.GetData() + FirstOp, NumOps), BatchSequence);
+		RecordReliableRpcSent();
 	}
 
-	ServerRegisterDroppedTool(ToolId, OwnerPlayerId, WorldLocation);
+	LastSentBatchSequence += PendingBatchOps.Num();
+	PendingBatchOps.Reset();
 }
 
-void UInventoryComponent::UpdateDroppedToolLocation(const FGuid& ToolId, const FVector& WorldLocation)
+void UInventoryComponent::RequestLocateTool(const FGuid& ToolId)
 {
 	if (GetOwner()->HasAuthority())
 	{
-		ServerUpdateDroppedToolLocation(ToolId, WorldLocation);
+		ServerRequestLocateTool(ToolId);
 		return;
 	}
 
-	ServerUpdateDroppedToolLocation(ToolId, WorldLocation);
+	ServerRequestLocateTool(ToolId);
+	RecordReliableRpcSent();
 }
 
-void UInventoryComponent::RemoveDroppedTool(const FGuid& ToolId)
+void UInventoryComponent::RequestLocateAllMyTools(int32 MaxResults)
 {
+	const uint8 ClampedMaxResults = static_cast<uint8>(FMath::Clamp(MaxResults, 1, MaxLocateAllResults));
 	if (GetOwner()->HasAuthority())
 	{
-		ServerRemoveDroppedTool(ToolId);
+		ServerRequestLocateAllTools(ClampedMaxResults);
 		return;
 	}
 
-	ServerRemoveDroppedTool(ToolId);
+	ServerRequestLocateAllTools(ClampedMaxResults);
+	RecordReliableRpcSent();
 }
 
-void UInventoryComponent::ServerAddToolToSlot_Implementation(UItemDefinitionDataAsset* ItemDefinition, const FGuid& ToolId, int32 SlotIndex)
+void UInventoryComponent::StartLocatorTracking(const FGuid& ToolId)
 {
-	if (!CanModifyInventory() || !ItemDefinition)
+	if (GetOwner()->HasAuthority())
 	{
+		ServerStartLocatorTracking(ToolId);
 		return;
 	}
 
-	if (SlotIndex < 0 || SlotIndex >= ToolSlots.Num())
+	ServerStartLocatorTracking(ToolId);
+	RecordReliableRpcSent();
+}
+
+void UInventoryComponent::StopLocatorTracking()
+{
+	if (GetOwner()->HasAuthority())
 	{
+		ServerStopLocatorTracking();
 		return;
 	}
 
-	FToolSlotEntry& Slot = ToolSlots[SlotIndex];
-	Slot.ItemDefinition = ItemDefinition;
-	Slot.ToolId = ToolId;
-	Slot.bOccupied = true;
-
-	OnToolSlotsChanged.Broadcast();
+	ServerStopLocatorTracking();
+	RecordReliableRpcSent();
 }
 
-void UInventoryComponent::ServerRemoveToolFromSlot_Implementation(int32 SlotIndex)
+void UInventoryComponent::RegisterOwnDroppedTool(const FGuid& ToolId, const FVector& WorldLocation)
 {
-	if (!CanModifyInventory())
+	if (GetOwner()->HasAuthority())
 	{
+		ServerRegisterDroppedTool(ToolId, WorldLocation);
 		return;
 	}
 
-	if (SlotIndex < 0 || SlotIndex >= ToolSlots.Num())
+	ServerRegisterDroppedTool(ToolId, WorldLocation);
+	RecordReliableRpcSent();
+}
+
+void UInventoryComponent::RegisterDroppedTool(const FGuid& ToolId, int32 OwnerPlayerId, const FVector& WorldLocation)
+{
+	if (OwnerPlayerId != INDEX_NONE && OwnerPlayerId != GetOwnerPlayerId())
 	{
+		UE_LOG(LogCowFieldCleanup, Warning, TEXT("%s: RegisterDroppedTool for player %d ignored; tools can only be registered for this component's player (%d)."),
+			*GetPathName(), OwnerPlayerId, GetOwnerPlayerId());
 		return;
 	}
 
-	FToolSlotEntry& Slot = ToolSlots[SlotIndex];
-	Slot.ItemDefinition = nullptr;
-	Slot.ToolId.Invalidate();
-	Slot.bOccupied = false;
-
-	OnToolSlotsChanged.Broadcast();
+	RegisterOwnDroppedTool(ToolId, WorldLocation);
 }
 
-void UInventoryComponent::ServerAddBagItem_Implementation(UItemDefinitionDataAsset* ItemDefinition, int32 Quantity)
+void UInventoryComponent::UpdateDroppedToolLocation(const FGuid& ToolId, const FVector& WorldLocation)
 {
-	if (!CanModifyInventory() || !ItemDefinition || Quantity <= 0)
+	if (GetOwner()->HasAuthority())
 	{
+		ApplyDroppedToolLocation(ToolId, WorldLocation);
 		return;
 	}
 
-	const float MaxBagWeight = GetMaxBagWeight();
-	const float IncomingWeight = ItemDefinition->ItemWeight * Quantity;
-	if (MaxBagWeight > 0.0f && (BagTotalWeight + IncomingWeight) > MaxBagWeight)
+	TryStreamDroppedToolLocation(ToolId, WorldLocation);
+}
+
+void UInventoryComponent::SettleDroppedToolLocation(const FGuid& ToolId, const FVector& WorldLocation)
+{
+	if (FDroppedToolStream* Stream = DroppedToolStreams.Find(ToolId))
 	{
-		return;
+		Stream->bBodyAwake = false;
+		Stream->LastSentLocation = WorldLocation;
+		Stream->bHasSent = true;
 	}
 
-	for (FBagItemEntry& Entry : BagEntries)
+	if (GetOwner()->HasAuthority())
 	{
-		if (Entry.ItemDefinition == ItemDefinition)
-		{
-			Entry.Quantity += Quantity;
-			RecalculateBagWeight();
-			OnBagEntriesChanged.Broadcast();
-			return;
-		}
+		ApplyDroppedToolLocation(ToolId, WorldLocation);
+		return;
 	}
 
-	FBagItemEntry NewEntry;
-	NewEntry.ItemDefinition = ItemDefinition;
-	NewEntry.Quantity = Quantity;
-	BagEntries.Add(NewEntry);
-
-	RecalculateBagWeight();
-	OnBagEntriesChanged.Broadcast();
+	ServerUpdateDroppedToolLocation(ToolId, WorldLocation);
+	RecordReliableRpcSent();
 }
 
-void UInventoryComponent::ServerRemoveBagItem_Implementation(UItemDefinitionDataAsset* ItemDefinition, int32 Quantity)
+void UInventoryComponent::BindDroppedToolBody(const FGuid& ToolId, UPrimitiveComponent* Body)
 {
-	if (!CanModifyInventory() || !ItemDefinition || Quantity <= 0)
+	if (!ToolId.IsValid() || !Body)
 	{
 		return;
 	}
 
-	for (int32 Index = 0; Index < BagEntries.Num(); ++Index)
+	LLM_SCOPE_BYTAG(Inventory);
+	FDroppedToolStream& Stream = DroppedToolStreams.FindOrAdd(ToolId);
+	if (UPrimitiveComponent* PreviousBody = Stream.Body.Get())
 	{
-		FBagItemEntry& Entry = BagEntries[Index];
-		if (Entry.ItemDefinition == ItemDefinition)
-		{
-			Entry.Quantity = FMath::Max(0, Entry.Quantity - Quantity);
-			if (Entry.Quantity == 0)
-			{
-				BagEntries.RemoveAt(Index);
-			}
-			RecalculateBagWeight();
-			OnBagEntriesChanged.Broadcast();
-			return;
-		}
+		PreviousBody->OnComponentWake.RemoveDynamic(this, &UInventoryComponent::HandleDroppedToolBodyWake);
+		PreviousBody->OnComponentSleep.RemoveDynamic(this, &UInventoryComponent::HandleDroppedToolBodySleep);
 	}
-}
 
-void UInventoryComponent::ServerRegisterDroppedTool_Implementation(const FGuid& ToolId, int32 OwnerPlayerId, const FVector& WorldLocation)
-{
-	if (!CanModifyInventory() || !ToolId.IsValid())
+	Stream.Body = Body;
+	Stream.bBodyAwake = Body->RigidBodyIsAwake();
+	Body->OnComponentWake.AddUniqueDynamic(this, &UInventoryComponent::HandleDroppedToolBodyWake);
+	Body->OnComponentSleep.AddUniqueDynamic(this, &UInventoryComponent::HandleDroppedToolBodySleep);
+
+	if (Stream.bBodyAwake)
 	{
-		return;
+		SetComponentTickEnabled(true);
 	}
+}
 
-	for (FTrackedTool& TrackedTool : TrackedTools)
+void UInventoryComponent::RemoveDroppedTool(const FGuid& ToolId)
+{
+	FDroppedToolStream Stream;
+	if (DroppedToolStreams.RemoveAndCopyValue(ToolId, Stream))
 	{
-		if (TrackedTool.ToolId == ToolId)
+		if (UPrimitiveComponent* Body = Stream.Body.Get())
 		{
-			TrackedTool.OwnerPlayerId = OwnerPlayerId;
-			TrackedTool.WorldLocation = WorldLocation;
-			TrackedTool.bIsDropped = true;
-			return;
+			Body->OnComponentWake.RemoveDynamic(this, &UInventoryComponent::HandleDroppedToolBodyWake);
+			Body->OnComponentSleep.RemoveDynamic(this, &UInventoryComponent::HandleDroppedToolBodySleep);
 		}
 	}
 
-	FTrackedTool NewTrackedTool;
-	NewTrackedTool.ToolId = ToolId;
-	NewTrackedTool.OwnerPlayerId = OwnerPlayerId;
-	NewTrackedTool.WorldLocation = WorldLocation;
-	NewTrackedTool.bIsDropped = true;
-	TrackedTools.Add(NewTrackedTool);
-}
-
-void UInventoryComponent::ServerUpdateDroppedToolLocation_Implementation(const FGuid& ToolId, const FVector& WorldLocation)
-{
-	if (!CanModifyInventory() || !ToolId.IsValid())
+	if (GetOwner()->HasAuthority())
 	{
+		ServerRemoveDroppedTool(ToolId);
 		return;
 	}
 
-	for (FTrackedTool& TrackedTool : TrackedTools)
-	{
-		if (TrackedTool.ToolId == ToolId)
-		{
-			TrackedTool.WorldLocation = WorldLocation;
-			TrackedTool.bIsDropped = true;
-			return;
-		}
-	}
+	ServerRemoveDroppedTool(ToolId);
+	RecordReliableRpcSent();
 }
 
-void UInventoryComponent::ServerRemoveDroppedTool_Implementation(const FGuid& ToolId)
+void UInventoryComponent::ServerAddToolToSlot_Implementation(UItemDefinitionDataAsset* ItemDefinition, const FGuid& ToolId, int32 SlotIndex)
 {
-	if (!CanModifyInventory() || !ToolId.IsValid())
+	INVENTORY_SCOPE_CYCLE_COUNTER(STAT_InventoryServerAddToolToSlot);
+	RecordReliableRpcReceived();
+
+	if (!ConsumeRpcBudget(EInventoryRpcFamily::Inventory))
 	{
 		return;
 	}
 
-	for (int32 Index = 0; Index < TrackedTools.Num(); ++Index)
+	if (!CanModifyInventory() || !ItemDefinition || !ToolSlots.IsValidIndex(SlotIndex))
 	{
-		if (TrackedTools[Index].ToolId == ToolId)
-		{
-			TrackedTools.RemoveAt(Index);
-			return;
-		}
+		return;
 	}
+
+	ApplyToolSlot(SlotIndex, ItemDefinition, ToolId);
+	MarkInventoryChanged(EInventoryChangeFlags::ToolSlots);
+	RecordInventoryEvent(EInventoryEventType::ToolSlotChanged, ItemDefinition, 1, SlotIndex, ToolId);
 }
 
-void UInventoryComponent::ServerRequestLocateTool_Implementation(const FGuid& ToolId)
+void UInventoryComponent::ServerRemoveToolFromSlot_Implementation(int32 SlotIndex)
 {
-	if (!CanModifyInventory() || !ToolId.IsValid())
+	INVENTORY_SCOPE_CYCLE_COUNTER(STAT_InventoryServerRemoveToolFromSlot);
+	RecordReliableRpcReceived();
+
+	if (!ConsumeRpcBudget(EInventoryRpcFamily::Inventory))
 	{
 		return;
 	}
 
-	const float CurrentTimeSeconds = GetWorld() ? GetWorld()->GetTimeSeconds() : 0.0f;
-	if (IsLocateOnCooldown(CurrentTimeSeconds))
+	if (!CanModifyInventory() || !ToolSlots.IsValidIndex(SlotIndex))
 	{
 		return;
 	}
 
-	const int32 OwnerPlayerId = GetOwnerPlayerId();
-	for (const FTrackedTool& TrackedTool : TrackedTools)
-	{
-		if (TrackedTool.ToolId == ToolId && TrackedTool.bIsDropped && TrackedTool.OwnerPlayerId == OwnerPlayerId)
-		{
-			const FVector OwnerLocation = GetOwnerLocation();
-			const FVector Offset = TrackedTool.WorldLocation - OwnerLocation;
-			const float Distance = Offset.Size();
-			const FVector Direction = Offset.IsNearlyZero() ? FVector::ZeroVector : Offset.GetSafeNormal();
-			const ELocatorDistanceBand DistanceBand = ResolveDistanceBand(Distance);
-
-			UpdateLocateCooldown(CurrentTimeSeconds);
-			ClientReceiveToolLocation(ToolId, Direction, DistanceBand, Distance);
-			OnToolLocatorResult.Broadcast(ToolId, DistanceBand, Distance);
-			return;
-		}
-	}
+	ApplyToolSlot(SlotIndex, nullptr, FGuid());
+	MarkInventoryChanged(EInventoryChangeFlags::ToolSlots);
+	RecordInventoryEvent(EInventoryEventType::ToolSlotChanged, nullptr, 0, SlotIndex);
 }
 
-void UInventoryComponent::ClientReceiveToolLocation_Implementation(const FGuid& ToolId, const FVector& Direction, ELocatorDistanceBand DistanceBand, float Distance)
+bool UInventoryComponent::ServerAddBagItem_Validate(UItemDefinitionDataAsset* ItemDefinition, int32 Quantity)
 {
-	OnToolLocatorResult.Broadcast(ToolId, DistanceBand, Distance);
+	return Quantity > 0;
 }
 
-void UInventoryComponent::OnRep_ToolSlots()
+void UInventoryComponent::ServerAddBagItem_Implementation(UItemDefinitionDataAsset* ItemDefinition, int32 Quantity)
 {
-	OnToolSlotsChanged.Broadcast();
-}
+	INVENTORY_SCOPE_CYCLE_COUNTER(STAT_InventoryServerAddBagItem);
+	RecordReliableRpcReceived();
 
-void UInventoryComponent::OnRep_BagEntries()
-{
-	OnBagEntriesChanged.Broadcast();
-}
+	if (!ConsumeRpcBudget(EInventoryRpcFamily::Inventory))
+	{
+		return;
+	}
 
-void UInventoryComponent::OnRep_BagTotalWeight()
-{
-	OnBagWeightChanged.Broadcast(BagTotalWeight);
+	TryAddBagItem(ItemDefinition, Quantity);
 }
 
-void UInventoryComponent::OnRep_TrackedTools()
+int32 UInventoryComponent::TryAddBagItem(UItemDefinitionDataAsset* ItemDefinition, int32 Quantity)
 {
-}
+	if (!CanModifyInventory() || !ItemDefinition || Quantity <= 0)
+	{
+		return 0;
+	}
 
-void UInventoryComponent::InitializeToolSlots()
-{
-	const int32 DesiredSlots = BalanceData ? BalanceData->MaxToolSlots : 3;
-	ToolSlots.SetNum(DesiredSlots);
-	for (FToolSlotEntry& Slot : ToolSlots)
+	if (!CanFitInBag(ItemDefinition, GetBagQuantity(ItemDefinition), Quantity, BagTotalWeight, BagStackCount))
 	{
-		Slot.bOccupied = false;
-		Slot.ItemDefinition = nullptr;
-		Slot.ToolId.Invalidate();
+		NotifyBagItemRefused(ItemDefinition, Quantity);
+		return 0;
 	}
+
+	ApplyAddBagItem(ItemDefinition, Quantity);
+	MarkInventoryChanged(EInventoryChangeFlags::BagEntries | EInventoryChangeFlags::BagWeight);
+	RecordInventoryEvent(EInventoryEventType::BagItemAdded, ItemDefinition, Quantity);
+	return Quantity;
 }
 
-void UInventoryComponent::RecalculateBagWeight()
+bool UInventoryComponent::CanFitInBag(const UItemDefinitionDataAsset* ItemDefinition, int32 ExistingQuantity, int32 Quantity, float CurrentWeight, int32 CurrentStacks) const
 {
-	float NewWeight = 0.0f;
-	for (const FBagItemEntry& Entry : BagEntries)
+	if (Quantity > MAX_int32 - ExistingQuantity)
 	{
-		if (Entry.ItemDefinition)
-		{
-			NewWeight += Entry.ItemDefinition->ItemWeight * Entry.Quantity;
-		}
+		return false;
 	}
 
-	BagTotalWeight = NewWeight;
-	OnBagWeightChanged.Broadcast(BagTotalWeight);
+	const float MaxBagWeight = GetMaxBagWeight();
+	if (MaxBagWeight > 0.0f && (CurrentWeight + ItemDefinition->ItemWeight * Quantity) > MaxBagWeight)
+	{
+		return false;
+	}
+
+	const int32 MaxBagStacks = GetMaxBagStacks();
+	const int32 AddedStacks = ItemDefinition->GetNumStacks(ExistingQuantity + Quantity) - ItemDefinition->GetNumStacks(ExistingQuantity);
+	return MaxBagStacks <= 0 || CurrentStacks + AddedStacks <= MaxBagStacks;
 }
 
-float UInventoryComponent::GetCurveValueSafe(const UCurveFloat* Curve) const
+int32 UInventoryComponent::CountBagStacks(TConstArrayView<FBagItemEntry> Entries) const
 {
-	if (!Curve)
+	int32 NumStacks = 0;
+	for (const FBagItemEntry& Entry : Entries)
 	{
-		return 1.0f;
+		NumStacks += Entry.ItemDefinition ? Entry.ItemDefinition->GetNumStacks(Entry.Quantity) : 0;
 	}
 
-	return Curve->GetFloatValue(BagTotalWeight);
+	return NumStacks;
 }
 
-float UInventoryComponent::GetMaxBagWeight() const
+void UInventoryComponent::NotifyBagItemRefused(UItemDefinitionDataAsset* ItemDefinition, int32 Quantity)
 {
-	return BalanceData ? BalanceData->MaxBagWeight : 0.0f;
+	// Runs in place when the owner is local or has no owning connection.
+	ClientBagItemRefused(ItemDefinition, Quantity);
+	RecordReliableRpcSent();
 }
 
-float UInventoryComponent::GetLocateCooldownSeconds() const
+void UInventoryComponent::ClientBagItemRefused_Implementation(UItemDefinitionDataAsset* ItemDefinition, int32 Quantity)
 {
-	return BalanceData ? BalanceData->LocateCooldownSeconds : 0.0f;
-}
+	INVENTORY_SCOPE_CYCLE_COUNTER(STAT_InventoryClientBagItemRefused);
+	RecordReliableRpcReceived();
 
-float UInventoryComponent::GetNearDistance() const
-{
-	return BalanceData ? BalanceData->NearDistance : 0.0f;
+	OnBagItemRefused.Broadcast(ItemDefinition, Quantity);
 }
 
-float UInventoryComponent::GetMediumDistance() const
+bool UInventoryComponent::ServerRemoveBagItem_Validate(UItemDefinitionDataAsset* ItemDefinition, int32 Quantity)
 {
-	return BalanceData ? BalanceData->MediumDistance : 0.0f;
+	return Quantity > 0;
 }
 
-ELocatorDistanceBand UInventoryComponent::ResolveDistanceBand(float Distance) const
+void UInventoryComponent::ServerRemoveBagItem_Implementation(UItemDefinitionDataAsset* ItemDefinition, int32 Quantity)
 {
-	const float NearDistance = GetNearDistance();
-	const float MediumDistance = GetMediumDistance();
+	INVENTORY_SCOPE_CYCLE_COUNTER(STAT_InventoryServerRemoveBagItem);
+	RecordReliableRpcReceived();
 
-	if (NearDistance <= 0.0f || MediumDistance <= 0.0f)
+	if (!ConsumeRpcBudget(EInventoryRpcFamily::Inventory))
 	{
-		return ELocatorDistanceBand::Unknown;
+		return;
 	}
 
-	if (Distance <= NearDistance)
+	if (!CanModifyInventory() || !ItemDefinition || Quantity <= 0)
 	{
-		return ELocatorDistanceBand::Near;
+		return;
 	}
 
-	if (Distance <= MediumDistance)
+	if (!ApplyRemoveBagItem(ItemDefinition, Quantity))
 	{
-		return ELocatorDistanceBand::Medium;
+		return;
 	}
 
-	return ELocatorDistanceBand::Far;
+	MarkInventoryChanged(EInventoryChangeFlags::BagEntries | EInventoryChangeFlags::BagWeight);
+	RecordInventoryEvent(EInventoryEventType::BagItemRemoved, ItemDefinition, Quantity);
 }
 
-FVector UInventoryComponent::GetOwnerLocation() const
+bool UInventoryComponent::ServerPickupLitter_Validate(ALitterField* LitterField, int32 LitterIndex)
 {
-	const AActor* OwnerActor = GetOwner();
-	return OwnerActor ? OwnerActor->GetActorLocation() : FVector::ZeroVector;
+	return LitterIndex >= 0;
 }
 
-int32 UInventoryComponent::GetOwnerPlayerId() const
+void UInventoryComponent::ServerPickupLitter_Implementation(ALitterField* LitterField, int32 LitterIndex)
 {
-	const AActor* OwnerActor = GetOwner();
-	const APlayerState* PlayerState = OwnerActor ? OwnerActor->GetPlayerState() : nullptr;
-	return PlayerState ? PlayerState->GetPlayerId() : INDEX_NONE;
-}
+	INVENTORY_SCOPE_CYCLE_COUNTER(STAT_InventoryServerPickupLitter);
+	RecordReliableRpcReceived();
 
-bool UInventoryComponent::IsLocateOnCooldown(float CurrentTimeSeconds) const
-{
-	const float Cooldown = GetLocateCooldownSeconds();
-	if (Cooldown <= 0.0f)
+	if (!ConsumeRpcBudget(EInventoryRpcFamily::Inventory))
 	{
-		return false;
+		return;
 	}
 
-	return LastLocateRequestTimeSeconds >= 0.0f && (CurrentTimeSeconds - LastLocateRequestTimeSeconds) < Cooldown;
-}
+	if (!CanModifyInventory() || !LitterField)
+	{
+		return;
+	}
 
-void UInventoryComponent::UpdateLocateCooldown(float CurrentTimeSeconds)
-{
+	UItemDefinitionDataAsset* ItemDefinition = LitterField->FindCollectableLitter(LitterIndex, GetOwnerLocation());
+	if (!ItemDefinition)
+	{
+		return;
+	}
+
+	// The add can still be refused by weight or stack limit; the litter only leaves the field if it landed in the bag.
+	if (TryAddBagItem(ItemDefinition, 1) > 0)
+	{
+		LitterField->MarkLitterCollected(LitterIndex);
+	}
+}
+
+bool UInventoryComponent::ServerApplyInventoryBatch_Validate(const TArray<FInventoryBatchOp>& Ops, uint32 BatchSequence)
+{
+	return Ops.Num() <= MaxInventoryBatchOps;
+}
+
+void UInventoryComponent::ServerApplyInventoryBatch_Implementation(const TArray<FInventoryBatchOp>& Ops, uint32 BatchSequence)
+{
+	INVENTORY_SCOPE_CYCLE_COUNTER(STAT_InventoryServerApplyInventoryBatch);
+	RecordReliableRpcReceived();
+
+	if (!CanModifyInventory())
+	{
+		return;
+	}
+
+	// Every batch is acked so a rejected one rolls back the client's prediction. The ack wakes a dormant owner itself,
+	// since a rejected batch changes nothing else that would.
+	const bool bWithinBudget = !Ops.IsEmpty() && Ops.Num() <= MaxInventoryBatchOps && ConsumeRpcBudget(EInventoryRpcFamily::Inventory, Ops.Num());
+
+	if (LastProcessedBatchSequence != BatchSequence)
+	{
+		LastProcessedBatchSequence = BatchSequence;
+		MARK_PROPERTY_DIRTY_FROM_NAME(UInventoryComponent, LastProcessedBatchSequence, this);
+		RecordReplicatedBytes(sizeof(LastProcessedBatchSequence));
+		WakeOwnerForReplication();
+	}
+
+	if (!bWithinBudget)
+	{
+		return;
+	}
+
+	TArray<TPair<const UItemDefinitionDataAsset*, int32>, TInlineAllocator<16>> ProjectedQuantities;
+	auto FindProjectedQuantity = [this, &ProjectedQuantities](const UItemDefinitionDataAsset* ItemDefinition) -> int32&
+	{
+		for (TPair<const UItemDefinitionDataAsset*, int32>& Projected : ProjectedQuantities)
+		{
+			if (Projected.Key == ItemDefinition)
+			{
+				return Projected.Value;
+			}
+		}
+
+		return ProjectedQuantities.Emplace_GetRef(ItemDefinition, GetBagQuantity(ItemDefinition)).Value;
+	};
+
+	float ProjectedWeight = BagTotalWeight;
+	int32 ProjectedStacks = BagStackCount;
+	bool bTouchesSlots = false;
+	bool bTouchesBag = false;
+
+	for (const FInventoryBatchOp& Op : Ops)
+	{
+		switch (Op.Type)
+		{
+		case EInventoryBatchOpType::AddToolToSlot:
+		case EInventoryBatchOpType::RemoveToolFromSlot:
+			if (!ToolSlots.IsValidIndex(Op.Argument) || (Op.Type == EInventoryBatchOpType::AddToolToSlot && !Op.ItemDefinition))
+			{
+				return;
+			}
+			bTouchesSlots = true;
+			break;
+
+		case EInventoryBatchOpType::AddBagItem:
+		{
+			if (!Op.ItemDefinition || Op.Argument <= 0)
+			{
+				return;
+			}
+
+			// Checked per op in order, as the client's prediction does, so both sides refuse the same add.
+			int32& ProjectedQuantity = FindProjectedQuantity(Op.ItemDefinition);
+			if (!CanFitInBag(Op.ItemDefinition, ProjectedQuantity, Op.Argument, ProjectedWeight, ProjectedStacks))
+			{
+				NotifyBagItemRefused(Op.ItemDefinition, Op.Argument);
+				return;
+			}
+
+			ProjectedStacks += Op.ItemDefinition->GetNumStacks(ProjectedQuantity + Op.Argument) - Op.ItemDefinition->GetNumStacks(ProjectedQuantity);
+			ProjectedQuantity += Op.Argument;
+			ProjectedWeight += Op.ItemDefinition->ItemWeight * Op.Argument;
+			bTouchesBag = true;
+			break;
+		}
+
+		case EInventoryBatchOpType::RemoveBagItem:
+		{
+			if (!Op.ItemDefinition || Op.Argument <= 0)
+			{
+				return;
+			}
+
+			int32& ProjectedQuantity = FindProjectedQuantity(Op.ItemDefinition);
+			const int32 RemovedQuantity = FMath::Min(Op.Argument, ProjectedQuantity);
+			ProjectedStacks -= Op.ItemDefinition->GetNumStacks(ProjectedQuantity) - Op.ItemDefinition->GetNumStacks(ProjectedQuantity - RemovedQuantity);
+			ProjectedQuantity -= RemovedQuantity;
+			ProjectedWeight -= Op.ItemDefinition->ItemWeight * RemovedQuantity;
+			bTouchesBag = true;
+			break;
+		}
+
+		default:
+			return;
+		}
+	}
+
+	for (const FInventoryBatchOp& Op : Ops)
+	{
+		switch (Op.Type)
+		{
+		case EInventoryBatchOpType::AddToolToSlot:
+			ApplyToolSlot(Op.Argument, Op.ItemDefinition, Op.ToolId);
+			RecordInventoryEvent(EInventoryEventType::ToolSlotChanged, Op.ItemDefinition, 1, Op.Argument, Op.ToolId);
+			break;
+
+		case EInventoryBatchOpType::RemoveToolFromSlot:
+			ApplyToolSlot(Op.Argument, nullptr, FGuid());
+			RecordInventoryEvent(EInventoryEventType::ToolSlotChanged, nullptr, 0, Op.Argument);
+			break;
+
+		case EInventoryBatchOpType::AddBagItem:
+			ApplyAddBagItem(Op.ItemDefinition, Op.Argument);
+			RecordInventoryEvent(EInventoryEventType::BagItemAdded, Op.ItemDefinition, Op.Argument);
+			break;
+
+		case EInventoryBatchOpType::RemoveBagItem:
+			if (ApplyRemoveBagItem(Op.ItemDefinition, Op.Argument))
+			{
+				RecordInventoryEvent(EInventoryEventType::BagItemRemoved, Op.ItemDefinition, Op.Argument);
+			}
+			break;
+		}
+	}
+
+	if (bTouchesSlots)
+	{
+		MarkInventoryChanged(EInventoryChangeFlags::ToolSlots);
+	}
+
+	if (bTouchesBag)
+	{
+		MarkInventoryChanged(EInventoryChangeFlags::BagEntries | EInventoryChangeFlags::BagWeight);
+	}
+}
+
+bool UInventoryComponent::ServerRegisterDroppedTool_Validate(const FGuid& ToolId, const FVector& WorldLocation)
+{
+	return InventoryComponentValidation::IsValidWorldLocation(WorldLocation);
+}
+
+void UInventoryComponent::ServerRegisterDroppedTool_Implementation(const FGuid& ToolId, const FVector& WorldLocation)
+{
+	INVENTORY_SCOPE_CYCLE_COUNTER(STAT_InventoryServerRegisterDroppedTool);
+	RecordReliableRpcReceived();
+
+	if (!ConsumeRpcBudget(EInventoryRpcFamily::DroppedTool))
+	{
+		return;
+	}
+
+	if (!CanModifyInventory() || !ToolId.IsValid())
+	{
+		return;
+	}
+
+	UDroppedToolRegistrySubsystem* ToolRegistry = GetToolRegistry();
+	if (!ToolRegistry)
+	{
+		return;
+	}
+
+	// Re-registering is how a player re-drops their own tool; it must not hand another player's record over.
+	if (ToolRegistry->FindTool(ToolId) && !OwnsDroppedTool(*ToolRegistry, ToolId))
+	{
+		return;
+	}
+
+	FTrackedTool TrackedTool;
+	TrackedTool.ToolId = ToolId;
+	TrackedTool.OwnerPlayerId = GetOwnerPlayerId();
+	TrackedTool.WorldLocation = WorldLocation;
+	TrackedTool.bIsDropped = true;
+
+	if (UInventoryComponent* PreviousComponent = ToolRegistry->RegisterTool(TrackedTool, this))
+	{
+		PreviousComponent->RemoveTrackedToolMirror(ToolId);
+	}
+
+	UpsertTrackedToolMirror(TrackedTool);
+	RecordInventoryEvent(EInventoryEventType::ToolDropped, nullptr, 0, INDEX_NONE, ToolId, WorldLocation);
+}
+
+bool UInventoryComponent::ServerUpdateDroppedToolLocation_Validate(const FGuid& ToolId, const FVector_NetQuantize10& WorldLocation)
+{
+	return InventoryComponentValidation::IsValidWorldLocation(WorldLocation);
+}
+
+void UInventoryComponent::ServerUpdateDroppedToolLocation_Implementation(const FGuid& ToolId, const FVector_NetQuantize10& WorldLocation)
+{
+	INVENTORY_SCOPE_CYCLE_COUNTER(STAT_InventoryServerUpdateDroppedToolLocation);
+	RecordReliableRpcReceived();
+
+	if (!ConsumeRpcBudget(EInventoryRpcFamily::DroppedTool))
+	{
+		return;
+	}
+
+	ApplyDroppedToolLocation(ToolId, WorldLocation);
+}
+
+bool UInventoryComponent::ServerStreamDroppedToolLocation_Validate(const FGuid& ToolId, const FVector_NetQuantize10& WorldLocation)
+{
+	return InventoryComponentValidation::IsValidWorldLocation(WorldLocation);
+}
+
+void UInventoryComponent::ServerStreamDroppedToolLocation_Implementation(const FGuid& ToolId, const FVector_NetQuantize10& WorldLocation)
+{
+	INVENTORY_SCOPE_CYCLE_COUNTER(STAT_InventoryServerStreamDroppedToolLocation);
+
+	if (!ConsumeRpcBudget(EInventoryRpcFamily::DroppedToolStream))
+	{
+		return;
+	}
+
+	ApplyDroppedToolLocation(ToolId, WorldLocation);
+}
+
+void UInventoryComponent::ApplyDroppedToolLocation(const FGuid& ToolId, const FVector& WorldLocation)
+{
+	if (!CanModifyInventory() || !ToolId.IsValid())
+	{
+		return;
+	}
+
+	UDroppedToolRegistrySubsystem* ToolRegistry = GetToolRegistry();
+	if (!ToolRegistry || !OwnsDroppedTool(*ToolRegistry, ToolId))
+	{
+		return;
+	}
+
+	UInventoryComponent* ReplicatingComponent = nullptr;
+	const FTrackedTool* TrackedTool = ToolRegistry->UpdateToolLocation(ToolId, WorldLocation, ReplicatingComponent);
+	if (TrackedTool && ReplicatingComponent)
+	{
+		ReplicatingComponent->UpsertTrackedToolMirror(*TrackedTool);
+	}
+
+	if (TrackedTool)
+	{
+		RecordInventoryEvent(EInventoryEventType::ToolMoved, nullptr, 0, INDEX_NONE, ToolId, WorldLocation);
+	}
+}
+
+void UInventoryComponent::ServerRemoveDroppedTool_Implementation(const FGuid& ToolId)
+{
+	INVENTORY_SCOPE_CYCLE_COUNTER(STAT_InventoryServerRemoveDroppedTool);
+	RecordReliableRpcReceived();
+
+	if (!ConsumeRpcBudget(EInventoryRpcFamily::DroppedTool))
+	{
+		return;
+	}
+
+	if (!CanModifyInventory() || !ToolId.IsValid())
+	{
+		return;
+	}
+
+	UDroppedToolRegistrySubsystem* ToolRegistry = GetToolRegistry();
+	if (!ToolRegistry || !OwnsDroppedTool(*ToolRegistry, ToolId))
+	{
+		return;
+	}
+
+	UInventoryComponent* ReplicatingComponent = nullptr;
+	if (!ToolRegistry->RemoveTool(ToolId, ReplicatingComponent))
+	{
+		return;
+	}
+
+	if (ReplicatingComponent)
+	{
+		ReplicatingComponent->RemoveTrackedToolMirror(ToolId);
+	}
+
+	RecordInventoryEvent(EInventoryEventType::ToolRemoved, nullptr, 0, INDEX_NONE, ToolId);
+}
+
+void UInventoryComponent::ServerRequestLocateTool_Implementation(const FGuid& ToolId)
+{
+	INVENTORY_SCOPE_CYCLE_COUNTER(STAT_InventoryServerRequestLocateTool);
+	RecordReliableRpcReceived();
+
+	if (!ConsumeRpcBudget(EInventoryRpcFamily::Locator))
+	{
+		return;
+	}
+
+	if (!CanModifyInventory() || !ToolId.IsValid())
+	{
+		return;
+	}
+
+	const float CurrentTimeSeconds = GetWorld() ? GetWorld()->GetTimeSeconds() : 0.0f;
+	if (IsLocateOnCooldown(CurrentTimeSeconds))
+	{
+		return;
+	}
+
+	const UDroppedToolRegistrySubsystem* ToolRegistry = GetToolRegistry();
+	const FTrackedTool* TrackedTool = ToolRegistry ? ToolRegistry->FindTool(ToolId) : nullptr;
+	if (!TrackedTool || !TrackedTool->bIsDropped || TrackedTool->OwnerPlayerId != GetOwnerPlayerId())
+	{
+		return;
+	}
+
+	const FVector Offset = TrackedTool->WorldLocation - GetOwnerLocation();
+	const float DistanceSquared = Offset.SizeSquared();
+
+	FToolLocatorResult Result;
+	Result.ToolId = ToolId;
+	Result.DistanceBand = ResolveDistanceBandSquared(DistanceSquared);
+	Result.DirectionYaw = FRotator::ClampAxis(FMath::RadiansToDegrees(FMath::Atan2(Offset.Y, Offset.X)));
+	Result.Distance = FMath::Sqrt(DistanceSquared);
+
+	UpdateLocateCooldown(CurrentTimeSeconds);
+	RecordInventoryEvent(EInventoryEventType::ToolLocated, nullptr, 0, INDEX_NONE, ToolId, TrackedTool->WorldLocation);
+	ClientReceiveToolLocation(Result);
+	RecordReliableRpcSent();
+	OnToolLocatorResult.Broadcast(ToolId, Result.DistanceBand, Result.Distance);
+}
+
+void UInventoryComponent::ClientReceiveToolLocation_Implementation(const FToolLocatorResult& Result)
+{
+	INVENTORY_SCOPE_CYCLE_COUNTER(STAT_InventoryClientReceiveToolLocation);
+	RecordReliableRpcReceived();
+
+	OnToolLocatorResult.Broadcast(Result.ToolId, Result.DistanceBand, Result.Distance);
+}
+
+bool UInventoryComponent::ServerRequestLocateAllTools_Validate(uint8 MaxResults)
+{
+	return MaxResults >= 1 && MaxResults <= MaxLocateAllResults;
+}
+
+void UInventoryComponent::ServerRequestLocateAllTools_Implementation(uint8 MaxResults)
+{
+	INVENTORY_SCOPE_CYCLE_COUNTER(STAT_InventoryServerRequestLocateAllTools);
+	RecordReliableRpcReceived();
+
+	if (!ConsumeRpcBudget(EInventoryRpcFamily::Locator))
+	{
+		return;
+	}
+
+	if (!CanModifyInventory())
+	{
+		return;
+	}
+
+	const float CurrentTimeSeconds = GetWorld() ? GetWorld()->GetTimeSeconds() : 0.0f;
+	if (IsLocateOnCooldown(CurrentTimeSeconds))
+	{
+		return;
+	}
+
+	const UDroppedToolRegistrySubsystem* ToolRegistry = GetToolRegistry();
+	if (!ToolRegistry)
+	{
+		return;
+	}
+
+	const FVector OwnerLocation = GetOwnerLocation();
+	TArray<UDroppedToolRegistrySubsystem::FNearestTool> NearestTools;
+	ToolRegistry->FindNearestToolsForOwner(GetOwnerPlayerId(), OwnerLocation, FMath::Clamp<int32>(MaxResults, 1, MaxLocateAllResults), NearestTools);
+
+	TArray<FToolLocatorResult> Results;
+	Results.Reserve(NearestTools.Num());
+	for (const UDroppedToolRegistrySubsystem::FNearestTool& NearestTool : NearestTools)
+	{
+		const FVector Offset = NearestTool.TrackedTool->WorldLocation - OwnerLocation;
+
+		FToolLocatorResult& Result = Results.AddDefaulted_GetRef();
+		Result.ToolId = NearestTool.TrackedTool->ToolId;
+		Result.DistanceBand = ResolveDistanceBandSquared(NearestTool.DistanceSquared);
+		Result.DirectionYaw = FRotator::ClampAxis(FMath::RadiansToDegrees(FMath::Atan2(Offset.Y, Offset.X)));
+		Result.Distance = FMath::Sqrt(NearestTool.DistanceSquared);
+	}
+
+	UpdateLocateCooldown(CurrentTimeSeconds);
+	RecordInventoryEvent(EInventoryEventType::AllToolsLocated, nullptr, Results.Num(), INDEX_NONE, FGuid(), OwnerLocation);
+	ClientReceiveToolLocations(Results);
+	RecordReliableRpcSent();
+	OnToolLocatorResults.Broadcast(Results);
+}
+
+void UInventoryComponent::ClientReceiveToolLocations_Implementation(const TArray<FToolLocatorResult>& Results)
+{
+	INVENTORY_SCOPE_CYCLE_COUNTER(STAT_InventoryClientReceiveToolLocations);
+	RecordReliableRpcReceived();
+
+	OnToolLocatorResults.Broadcast(Results);
+}
+
+void UInventoryComponent::ServerStartLocatorTracking_Implementation(const FGuid& ToolId)
+{
+	INVENTORY_SCOPE_CYCLE_COUNTER(STAT_InventoryServerStartLocatorTracking);
+	RecordReliableRpcReceived();
+
+	if (!ConsumeRpcBudget(EInventoryRpcFamily::Locator))
+	{
+		return;
+	}
+
+	if (!CanModifyInventory() || !ToolId.IsValid())
+	{
+		return;
+	}
+
+	const UDroppedToolRegistrySubsystem* ToolRegistry = GetToolRegistry();
+	const FTrackedTool* TrackedTool = ToolRegistry ? ToolRegistry->FindTool(ToolId) : nullptr;
+	if (!TrackedTool || !TrackedTool->bIsDropped || TrackedTool->OwnerPlayerId != GetOwnerPlayerId())
+	{
+		return;
+	}
+
+	if (UToolLocatorTrackingSubsystem* LocatorTracking = GetLocatorTracking())
+	{
+		LocatorTracking->Subscribe(this, ToolId);
+	}
+}
+
+void UInventoryComponent::ServerStopLocatorTracking_Implementation()
+{
+	INVENTORY_SCOPE_CYCLE_COUNTER(STAT_InventoryServerStopLocatorTracking);
+	RecordReliableRpcReceived();
+
+	if (!ConsumeRpcBudget(EInventoryRpcFamily::Locator))
+	{
+		return;
+	}
+
+	if (UToolLocatorTrackingSubsystem* LocatorTracking = GetLocatorTracking())
+	{
+		LocatorTracking->Unsubscribe(this);
+	}
+}
+
+void UInventoryComponent::ClientReceiveLocatorTracking_Implementation(const FGuid& ToolId, ELocatorDistanceBand DistanceBand, uint8 DirectionSector, uint16 DistanceMeters)
+{
+	INVENTORY_SCOPE_CYCLE_COUNTER(STAT_InventoryClientReceiveLocatorTracking);
+
+	OnLocatorTrackingUpdate.Broadcast(ToolId, DistanceBand, UToolLocatorTrackingSubsystem::GetDirectionSectorYaw(DirectionSector), DistanceMeters * 100.0f);
+}
+
+void UInventoryComponent::OnRep_ToolSlots()
+{
+	INVENTORY_SCOPE_CYCLE_COUNTER(STAT_InventoryOnRepToolSlots);
+
+	if (IsPredicting())
+	{
+		RequestReconcile();
+		return;
+	}
+
+	MarkInventoryChanged(EInventoryChangeFlags::ToolSlots);
+}
+
+void UInventoryComponent::OnRep_BagEntries()
+{
+	INVENTORY_SCOPE_CYCLE_COUNTER(STAT_InventoryOnRepBagEntries);
+
+	if (IsPredicting())
+	{
+		RequestReconcile();
+		return;
+	}
+
+	MarkInventoryChanged(EInventoryChangeFlags::BagEntries);
+}
+
+void UInventoryComponent::OnRep_BagTotalWeight()
+{
+	INVENTORY_SCOPE_CYCLE_COUNTER(STAT_InventoryOnRepBagTotalWeight);
+
+	if (IsPredicting())
+	{
+		RequestReconcile();
+		return;
+	}
+
+	RefreshCachedMultipliers();
+	MarkInventoryChanged(EInventoryChangeFlags::BagWeight);
+}
+
+void UInventoryComponent::OnRep_TrackedTools()
+{
+	INVENTORY_SCOPE_CYCLE_COUNTER(STAT_InventoryOnRepTrackedTools);
+
+	MarkInventoryChanged(EInventoryChangeFlags::TrackedTools);
+}
+
+void UInventoryComponent::OnRep_LastProcessedBatchSequence()
+{
+	INVENTORY_SCOPE_CYCLE_COUNTER(STAT_InventoryOnRepLastProcessedBatchSequence);
+
+	if (IsPredicting())
+	{
+		RequestReconcile();
+	}
+}
+
+void UInventoryComponent::HandleBagEntryReplicated(const FBagItemEntry& Entry, EInventoryEntryChange Change)
+{
+	if (IsPredicting())
+	{
+		return;
+	}
+
+	OnBagEntryChanged.Broadcast(Entry, Change);
+}
+
+void UInventoryComponent::HandleTrackedToolReplicated(const FTrackedTool& TrackedTool, EInventoryEntryChange Change)
+{
+	OnTrackedToolChanged.Broadcast(TrackedTool, Change);
+}
+
+void UInventoryComponent::UpsertTrackedToolMirror(const FTrackedTool& TrackedTool)
+{
+	if (const int32* ExistingIndex = TrackedToolIndexById.Find(TrackedTool.ToolId))
+	{
+		FTrackedTool& MirroredTool = TrackedTools.Items[*ExistingIndex];
+		MirroredTool.OwnerPlayerId = TrackedTool.OwnerPlayerId;
+		MirroredTool.WorldLocation = TrackedTool.WorldLocation;
+		MirroredTool.bIsDropped = TrackedTool.bIsDropped;
+		TrackedTools.MarkItemDirty(MirroredTool);
+		MARK_PROPERTY_DIRTY_FROM_NAME(UInventoryComponent, TrackedTools, this);
+		RecordReplicatedBytes(InventoryStats::EstimateReplicatedBytes(MirroredTool));
+		OnTrackedToolChanged.Broadcast(MirroredTool, EInventoryEntryChange::Changed);
+		MarkInventoryChanged(EInventoryChangeFlags::TrackedTools);
+		return;
+	}
+
+	LLM_SCOPE_BYTAG(Inventory);
+	const int32 NewIndex = TrackedTools.Items.AddDefaulted();
+	FTrackedTool& MirroredTool = TrackedTools.Items[NewIndex];
+	MirroredTool.ToolId = TrackedTool.ToolId;
+	MirroredTool.OwnerPlayerId = TrackedTool.OwnerPlayerId;
+	MirroredTool.WorldLocation = TrackedTool.WorldLocation;
+	MirroredTool.bIsDropped = TrackedTool.bIsDropped;
+	TrackedTools.MarkItemDirty(MirroredTool);
+	MARK_PROPERTY_DIRTY_FROM_NAME(UInventoryComponent, TrackedTools, this);
+	TrackedToolIndexById.Add(TrackedTool.ToolId, NewIndex);
+	RecordReplicatedBytes(InventoryStats::EstimateReplicatedBytes(MirroredTool));
+	OnTrackedToolChanged.Broadcast(MirroredTool, EInventoryEntryChange::Added);
+	MarkInventoryChanged(EInventoryChangeFlags::TrackedTools);
+}
+
+void UInventoryComponent::RemoveTrackedToolMirror(const FGuid& ToolId)
+{
+	int32 RemovedIndex = INDEX_NONE;
+	if (!TrackedToolIndexById.RemoveAndCopyValue(ToolId, RemovedIndex))
+	{
+		return;
+	}
+
+	const FTrackedTool RemovedTrackedTool = TrackedTools.Items[RemovedIndex];
+	TrackedTools.Items.RemoveAtSwap(RemovedIndex, 1, EAllowShrinking::No);
+	if (TrackedTools.Items.IsValidIndex(RemovedIndex))
+	{
+		TrackedToolIndexById.FindChecked(TrackedTools.Items[RemovedIndex].ToolId) = RemovedIndex;
+	}
+
+	TrackedTools.MarkArrayDirty();
+	MARK_PROPERTY_DIRTY_FROM_NAME(UInventoryComponent, TrackedTools, this);
+	RecordReplicatedBytes(sizeof(int32));
+	OnTrackedToolChanged.Broadcast(RemovedTrackedTool, EInventoryEntryChange::Removed);
+	MarkInventoryChanged(EInventoryChangeFlags::TrackedTools);
+}
+
+bool UInventoryComponent::TryStreamDroppedToolLocation(const FGuid& ToolId, const FVector& WorldLocation)
+{
+	if (!ToolId.IsValid())
+	{
+		return false;
+	}
+
+	// Snap to the stream RPC's FVector_NetQuantize10 precision so the authority's own bodies move in the same steps.
+	const FVector QuantizedLocation = WorldLocation.GridSnap(0.1);
+
+	FDroppedToolStream& Stream = DroppedToolStreams.FindOrAdd(ToolId);
+	if (Stream.bHasSent && FVector::DistSquared(Stream.LastSentLocation, QuantizedLocation) < BalanceProfile->DroppedToolMinSendDistanceSquared)
+	{
+		return false;
+	}
+
+	const double CurrentTimeSeconds = GetWorld() ? GetWorld()->GetTimeSeconds() : 0.0;
+	if (!Stream.bHasSent)
+	{
+		Stream.SendTokens = BalanceProfile->DroppedToolSendBurst;
+	}
+	else
+	{
+		const float RefilledTokens = static_cast<float>(CurrentTimeSeconds - Stream.LastRefillTimeSeconds) * BalanceProfile->DroppedToolSendsPerSecond;
+		Stream.SendTokens = FMath::Min(BalanceProfile->DroppedToolSendBurst, Stream.SendTokens + RefilledTokens);
+	}
+	Stream.LastRefillTimeSeconds = CurrentTimeSeconds;
+
+	if (Stream.SendTokens < 1.0f)
+	{
+		return false;
+	}
+
+	Stream.SendTokens -= 1.0f;
+	Stream.LastSentLocation = QuantizedLocation;
+	Stream.bHasSent = true;
+
+	if (GetOwner()->HasAuthority())
+	{
+		ApplyDroppedToolLocation(ToolId, QuantizedLocation);
+		return true;
+	}
+
+	ServerStreamDroppedToolLocation(ToolId, QuantizedLocation);
+	return true;
+}
+
+void UInventoryComponent::StreamAwakeDroppedToolBodies()
+{
+	for (TPair<FGuid, FDroppedToolStream>& StreamPair : DroppedToolStreams)
+	{
+		const UPrimitiveComponent* Body = StreamPair.Value.Body.Get();
+		if (!StreamPair.Value.bBodyAwake || !Body)
+		{
+			continue;
+		}
+
+		// Throttled on the authority too; otherwise every awake body would dirty its mirror and log a move each tick.
+		TryStreamDroppedToolLocation(StreamPair.Key, Body->GetComponentLocation());
+	}
+}
+
+bool UInventoryComponent::HasAwakeDroppedToolBodies() const
+{
+	for (const TPair<FGuid, FDroppedToolStream>& StreamPair : DroppedToolStreams)
+	{
+		if (StreamPair.Value.bBodyAwake && StreamPair.Value.Body.IsValid())
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+void UInventoryComponent::HandleDroppedToolBodyWake(UPrimitiveComponent* WakingComponent, FName BoneName)
+{
+	for (TPair<FGuid, FDroppedToolStream>& StreamPair : DroppedToolStreams)
+	{
+		if (StreamPair.Value.Body.Get() == WakingComponent)
+		{
+			StreamPair.Value.bBodyAwake = true;
+			SetComponentTickEnabled(true);
+			return;
+		}
+	}
+}
+
+void UInventoryComponent::HandleDroppedToolBodySleep(UPrimitiveComponent* SleepingComponent, FName BoneName)
+{
+	for (const TPair<FGuid, FDroppedToolStream>& StreamPair : DroppedToolStreams)
+	{
+		if (StreamPair.Value.Body.Get() == SleepingComponent)
+		{
+			SettleDroppedToolLocation(StreamPair.Key, SleepingComponent->GetComponentLocation());
+			return;
+		}
+	}
+}
+
+UDroppedToolRegistrySubsystem* UInventoryComponent::GetToolRegistry() const
+{
+	const UWorld* World = GetWorld();
+	return World ? World->GetSubsystem<UDroppedToolRegistrySubsystem>() : nullptr;
+}
+
+UToolLocatorTrackingSubsystem* UInventoryComponent::GetLocatorTracking() const
+{
+	const UWorld* World = GetWorld();
+	return World ? World->GetSubsystem<UToolLocatorTrackingSubsystem>() : nullptr;
+}
+
+void UInventoryComponent::InitializeToolSlots()
+{
+	const int32 DesiredSlots = BalanceProfile->MaxToolSlots;
+	ToolSlots.SetNum(DesiredSlots);
+	for (FToolSlotEntry& Slot : ToolSlots)
+	{
+		Slot.bOccupied = false;
+		Slot.ItemDefinition = nullptr;
+		Slot.ToolId.Invalidate();
+	}
+
+	MARK_PROPERTY_DIRTY_FROM_NAME(UInventoryComponent, ToolSlots, this);
+}
+
+void UInventoryComponent::QueueBatchOp(EInventoryBatchOpType Type, UItemDefinitionDataAsset* ItemDefinition, const FGuid& ToolId, int32 Argument)
+{
+	LLM_SCOPE_BYTAG(Inventory);
+
+	if (PendingBatchOps.IsEmpty())
+	{
+		SetComponentTickEnabled(true);
+	}
+
+	FInventoryBatchOp& Op = PendingBatchOps.AddDefaulted_GetRef();
+	Op.Type = Type;
+	Op.ItemDefinition = ItemDefinition;
+	Op.ToolId = ToolId;
+	Op.Argument = Argument;
+
+	FPredictedInventoryOp& PredictedOp = PredictedOps.AddDefaulted_GetRef();
+	PredictedOp.Sequence = LastSentBatchSequence + PendingBatchOps.Num();
+	PredictedOp.Op = Op;
+
+	UpdatePredictedView();
+}
+
+void UInventoryComponent::MarkInventoryChanged(EInventoryChangeFlags ChangeMask)
+{
+	if (PendingChangeMask == EInventoryChangeFlags::None)
+	{
+		SetComponentTickEnabled(true);
+
+		if (CanModifyInventory())
+		{
+			WakeOwnerForReplication();
+		}
+	}
+
+	PendingChangeMask |= ChangeMask;
+}
+
+void UInventoryComponent::DispatchInventoryChanges()
+{
+	const EInventoryChangeFlags ChangeMask = PendingChangeMask;
+	PendingChangeMask = EInventoryChangeFlags::None;
+
+	OnInventoryChanged.Broadcast(static_cast<int32>(ChangeMask));
+
+	if (!bBroadcastLegacyDelegates)
+	{
+		return;
+	}
+
+	if (EnumHasAnyFlags(ChangeMask, EInventoryChangeFlags::ToolSlots))
+	{
+		OnToolSlotsChanged.Broadcast();
+	}
+
+	if (EnumHasAnyFlags(ChangeMask, EInventoryChangeFlags::BagWeight))
+	{
+		OnBagWeightChanged.Broadcast(GetBagTotalWeight());
+	}
+
+	if (EnumHasAnyFlags(ChangeMask, EInventoryChangeFlags::BagEntries))
+	{
+		OnBagEntriesChanged.Broadcast();
+	}
+}
+
+bool UInventoryComponent::IsPredicting() const
+{
+	return bHasPredictedView || !PredictedOps.IsEmpty();
+}
+
+void UInventoryComponent::RequestReconcile()
+{
+	if (!bReconcilePending)
+	{
+		bReconcilePending = true;
+		SetComponentTickEnabled(true);
+	}
+}
+
+void UInventoryComponent::ReconcilePredictedOps()
+{
+	bReconcilePending = false;
+
+	const int32 NumAcked = Algo::LowerBoundBy(PredictedOps, LastProcessedBatchSequence + 1, &FPredictedInventoryOp::Sequence);
+	PredictedOps.RemoveAt(0, NumAcked, EAllowShrinking::No);
+
+	UpdatePredictedView();
+}
+
+void UInventoryComponent::UpdatePredictedView()
+{
+	// Runs on every queued op and reconcile, so the snapshot and predicted arrays keep their allocations between calls.
+	// The snapshot is moved out while in use because change handlers may queue another op and re-enter.
+	TArray<FToolSlotEntry> PreviousToolSlots = MoveTemp(PreviousToolSlotsScratch);
+	TArray<FBagItemEntry> PreviousBagEntries = MoveTemp(PreviousBagEntriesScratch);
+	PreviousToolSlots.Reset();
+	PreviousToolSlots.Append(GetToolSlots());
+	PreviousBagEntries.Reset();
+	PreviousBagEntries.Append(GetBagEntries());
+	const float PreviousBagWeight = GetBagTotalWeight();
+
+	bHasPredictedView = !PredictedOps.IsEmpty();
+	if (bHasPredictedView)
+	{
+		PredictedToolSlots.Reset();
+		PredictedToolSlots.Append(ToolSlots);
+		PredictedBagEntries.Reset();
+		PredictedBagEntries.Append(BagEntries.Items);
+		PredictedBagWeight = BagTotalWeight;
+		PredictedBagStacks = GetMaxBagStacks() > 0 ? CountBagStacks(PredictedBagEntries) : 0;
+
+		for (const FPredictedInventoryOp& PredictedOp : PredictedOps)
+		{
+			ApplyPredictedOp(PredictedOp.Op);
+		}
+	}
+	else
+	{
+		PredictedToolSlots.Reset();
+		PredictedBagEntries.Reset();
+		PredictedBagWeight = 0.0f;
+		PredictedBagStacks = 0;
+	}
+
+	const TArray<FToolSlotEntry>& VisibleToolSlots = GetToolSlots();
+	bool bToolSlotsChanged = VisibleToolSlots.Num() != PreviousToolSlots.Num();
+	for (int32 SlotIndex = 0; !bToolSlotsChanged && SlotIndex < VisibleToolSlots.Num(); ++SlotIndex)
+	{
+		const FToolSlotEntry& Visible = VisibleToolSlots[SlotIndex];
+		const FToolSlotEntry& Previous = PreviousToolSlots[SlotIndex];
+		bToolSlotsChanged = Visible.ItemDefinition != Previous.ItemDefinition || Visible.ToolId != Previous.ToolId || Visible.bOccupied != Previous.bOccupied;
+	}
+
+	const TArray<FBagItemEntry>& VisibleBagEntries = GetBagEntries();
+	bool bBagEntriesChanged = false;
+	for (const FBagItemEntry& Visible : VisibleBagEntries)
+	{
+		const FBagItemEntry* Previous = PreviousBagEntries.FindByPredicate([&Visible](const FBagItemEntry& Entry) { return Entry.ItemDefinition == Visible.ItemDefinition; });
+		if (!Previous)
+		{
+			OnBagEntryChanged.Broadcast(Visible, EInventoryEntryChange::Added);
+			bBagEntriesChanged = true;
+		}
+		else if (Previous->Quantity != Visible.Quantity)
+		{
+			OnBagEntryChanged.Broadcast(Visible, EInventoryEntryChange::Changed);
+			bBagEntriesChanged = true;
+		}
+	}
+
+	for (const FBagItemEntry& Previous : PreviousBagEntries)
+	{
+		if (!VisibleBagEntries.ContainsByPredicate([&Previous](const FBagItemEntry& Entry) { return Entry.ItemDefinition == Previous.ItemDefinition; }))
+		{
+			OnBagEntryChanged.Broadcast(Previous, EInventoryEntryChange::Removed);
+			bBagEntriesChanged = true;
+		}
+	}
+
+	if (bToolSlotsChanged)
+	{
+		MarkInventoryChanged(EInventoryChangeFlags::ToolSlots);
+	}
+
+	if (PreviousBagWeight != GetBagTotalWeight())
+	{
+		RefreshCachedMultipliers();
+		MarkInventoryChanged(EInventoryChangeFlags::BagWeight);
+	}
+
+	if (bBagEntriesChanged)
+	{
+		MarkInventoryChanged(EInventoryChangeFlags::BagEntries);
+	}
+
+	PreviousToolSlotsScratch = MoveTemp(PreviousToolSlots);
+	PreviousBagEntriesScratch = MoveTemp(PreviousBagEntries);
+}
+
+void UInventoryComponent::ApplyPredictedOp(const FInventoryBatchOp& Op)
+{
+	switch (Op.Type)
+	{
+	case EInventoryBatchOpType::AddToolToSlot:
+	case EInventoryBatchOpType::RemoveToolFromSlot:
+		if (PredictedToolSlots.IsValidIndex(Op.Argument))
+		{
+			FToolSlotEntry& Slot = PredictedToolSlots[Op.Argument];
+			const bool bAdd = Op.Type == EInventoryBatchOpType::AddToolToSlot;
+			Slot.ItemDefinition = bAdd ? Op.ItemDefinition : nullptr;
+			Slot.ToolId = bAdd ? Op.ToolId : FGuid();
+			Slot.bOccupied = bAdd;
+		}
+		break;
+
+	case EInventoryBatchOpType::AddBagItem:
+	{
+		FBagItemEntry* Entry = PredictedBagEntries.FindByPredicate([&Op](const FBagItemEntry& Candidate) { return Candidate.ItemDefinition == Op.ItemDefinition; });
+		const int32 ExistingQuantity = Entry ? Entry->Quantity : 0;
+		if (!CanFitInBag(Op.ItemDefinition, ExistingQuantity, Op.Argument, PredictedBagWeight, PredictedBagStacks))
+		{
+			break;
+		}
+
+		if (!Entry)
+		{
+			Entry = &PredictedBagEntries.AddDefaulted_GetRef();
+			Entry->ItemDefinition = Op.ItemDefinition;
+		}
+
+		PredictedBagStacks += Op.ItemDefinition->GetNumStacks(ExistingQuantity + Op.Argument) - Op.ItemDefinition->GetNumStacks(ExistingQuantity);
+		Entry->Quantity += Op.Argument;
+		PredictedBagWeight += Op.ItemDefinition->ItemWeight * Op.Argument;
+		break;
+	}
+
+	case EInventoryBatchOpType::RemoveBagItem:
+	{
+		const int32 EntryIndex = PredictedBagEntries.IndexOfByPredicate([&Op](const FBagItemEntry& Candidate) { return Candidate.ItemDefinition == Op.ItemDefinition; });
+		if (EntryIndex == INDEX_NONE)
+		{
+			break;
+		}
+
+		FBagItemEntry& Entry = PredictedBagEntries[EntryIndex];
+		const int32 RemovedQuantity = FMath::Min(Op.Argument, Entry.Quantity);
+		PredictedBagStacks -= Op.ItemDefinition->GetNumStacks(Entry.Quantity) - Op.ItemDefinition->GetNumStacks(Entry.Quantity - RemovedQuantity);
+		Entry.Quantity -= RemovedQuantity;
+		PredictedBagWeight = FMath::Max(0.0f, PredictedBagWeight - Op.ItemDefinition->ItemWeight * RemovedQuantity);
+		if (Entry.Quantity == 0)
+		{
+			PredictedBagEntries.RemoveAtSwap(EntryIndex, 1, EAllowShrinking::No);
+		}
+		break;
+	}
+	}
+}
+
+void UInventoryComponent::ApplyToolSlot(int32 SlotIndex, UItemDefinitionDataAsset* ItemDefinition, const FGuid& ToolId)
+{
+	FToolSlotEntry& Slot = ToolSlots[SlotIndex];
+	Slot.ItemDefinition = ItemDefinition;
+	Slot.ToolId = ItemDefinition ? ToolId : FGuid();
+	Slot.bOccupied = ItemDefinition != nullptr;
+	MARK_PROPERTY_DIRTY_FROM_NAME(UInventoryComponent, ToolSlots, this);
+	RecordReplicatedBytes(InventoryStats::EstimateReplicatedBytes(Slot));
+}
+
+void UInventoryComponent::ApplyAddBagItem(UItemDefinitionDataAsset* ItemDefinition, int32 Quantity)
+{
+	const float IncomingWeight = ItemDefinition->ItemWeight * Quantity;
+	if (const int32* ExistingIndex = BagIndexByDefinition.Find(ItemDefinition))
+	{
+		FBagItemEntry& Entry = BagEntries.Items[*ExistingIndex];
+		BagStackCount += ItemDefinition->GetNumStacks(Entry.Quantity + Quantity) - ItemDefinition->GetNumStacks(Entry.Quantity);
+		Entry.Quantity += Quantity;
+		BagEntries.MarkItemDirty(Entry);
+		MARK_PROPERTY_DIRTY_FROM_NAME(UInventoryComponent, BagEntries, this);
+		RecordReplicatedBytes(InventoryStats::EstimateReplicatedBytes(Entry) + sizeof(BagTotalWeight));
+		ApplyBagWeightDelta(IncomingWeight);
+		PushTeamProgressDelta(ItemDefinition, Quantity);
+		OnBagEntryChanged.Broadcast(Entry, EInventoryEntryChange::Changed);
+		return;
+	}
+
+	LLM_SCOPE_BYTAG(Inventory);
+	const int32 NewIndex = BagEntries.Items.AddDefaulted();
+	FBagItemEntry& NewEntry = BagEntries.Items[NewIndex];
+	NewEntry.ItemDefinition = ItemDefinition;
+	NewEntry.Quantity = Quantity;
+	BagEntries.MarkItemDirty(NewEntry);
+	MARK_PROPERTY_DIRTY_FROM_NAME(UInventoryComponent, BagEntries, this);
+	BagIndexByDefinition.Add(ItemDefinition, NewIndex);
+	BagStackCount += ItemDefinition->GetNumStacks(Quantity);
+	RecordReplicatedBytes(InventoryStats::EstimateReplicatedBytes(NewEntry) + sizeof(BagTotalWeight));
+
+	ApplyBagWeightDelta(IncomingWeight);
+	PushTeamProgressDelta(ItemDefinition, Quantity);
+	OnBagEntryChanged.Broadcast(NewEntry, EInventoryEntryChange::Added);
+}
+
+bool UInventoryComponent::ApplyRemoveBagItem(UItemDefinitionDataAsset* ItemDefinition, int32 Quantity)
+{
+	const int32* ExistingIndex = BagIndexByDefinition.Find(ItemDefinition);
+	if (!ExistingIndex)
+	{
+		return false;
+	}
+
+	const int32 EntryIndex = *ExistingIndex;
+	FBagItemEntry& Entry = BagEntries.Items[EntryIndex];
+	const int32 RemovedQuantity = FMath::Min(Quantity, Entry.Quantity);
+	const float RemovedWeight = ItemDefinition->ItemWeight * RemovedQuantity;
+
+	BagStackCount -= ItemDefinition->GetNumStacks(Entry.Quantity) - ItemDefinition->GetNumStacks(Entry.Quantity - RemovedQuantity);
+	Entry.Quantity -= RemovedQuantity;
+	if (Entry.Quantity > 0)
+	{
+		BagEntries.MarkItemDirty(Entry);
+		MARK_PROPERTY_DIRTY_FROM_NAME(UInventoryComponent, BagEntries, this);
+		RecordReplicatedBytes(InventoryStats::EstimateReplicatedBytes(Entry) + sizeof(BagTotalWeight));
+		ApplyBagWeightDelta(-RemovedWeight);
+		PushTeamProgressDelta(ItemDefinition, -RemovedQuantity);
+		OnBagEntryChanged.Broadcast(Entry, EInventoryEntryChange::Changed);
+		return true;
+	}
+
+	const FBagItemEntry RemovedEntry = Entry;
+	BagIndexByDefinition.Remove(ItemDefinition);
+	BagEntries.Items.RemoveAtSwap(EntryIndex, 1, EAllowShrinking::No);
+	if (BagEntries.Items.IsValidIndex(EntryIndex))
+	{
+		BagIndexByDefinition.FindChecked(BagEntries.Items[EntryIndex].ItemDefinition.Get()) = EntryIndex;
+	}
+
+	BagEntries.MarkArrayDirty();
+	MARK_PROPERTY_DIRTY_FROM_NAME(UInventoryComponent, BagEntries, this);
+	RecordReplicatedBytes(sizeof(int32) + sizeof(BagTotalWeight));
+	ApplyBagWeightDelta(-RemovedWeight);
+	PushTeamProgressDelta(ItemDefinition, -RemovedQuantity);
+	OnBagEntryChanged.Broadcast(RemovedEntry, EInventoryEntryChange::Removed);
+	return true;
+}
+
+int32 UInventoryComponent::GetBagQuantity(const UItemDefinitionDataAsset* ItemDefinition) const
+{
+	const int32* ExistingIndex = BagIndexByDefinition.Find(ItemDefinition);
+	return ExistingIndex ? BagEntries.Items[*ExistingIndex].Quantity : 0;
+}
+
+void UInventoryComponent::PushTeamProgressDelta(const UItemDefinitionDataAsset* ItemDefinition, int32 QuantityDelta)
+{
+	ACowFieldCleanupGameState* GameState = GetWorld() ? GetWorld()->GetGameState<ACowFieldCleanupGameState>() : nullptr;
+	if (!GameState || QuantityDelta == 0)
+	{
+		return;
+	}
+
+	const int32 PlayerId = GetOwnerPlayerId();
+	if (PlayerId != TeamProgressPlayerId)
+	{
+		GameState->ReassignPlayerLoad(TeamProgressPlayerId, PlayerId);
+		TeamProgressPlayerId = PlayerId;
+	}
+
+	GameState->ApplyInventoryDelta(PlayerId, ItemDefinition, QuantityDelta);
+}
+
+void UInventoryComponent::RecalculateBagWeight()
+{
+	INVENTORY_SCOPE_CYCLE_COUNTER(STAT_InventoryRecalculateBagWeight);
+
+	float NewWeight = 0.0f;
+	for (const FBagItemEntry& Entry : BagEntries.Items)
+	{
+		if (Entry.ItemDefinition)
+		{
+			NewWeight += Entry.ItemDefinition->ItemWeight * Entry.Quantity;
+		}
+	}
+
+	BagTotalWeight = NewWeight;
+	MARK_PROPERTY_DIRTY_FROM_NAME(UInventoryComponent, BagTotalWeight, this);
+	RecordReplicatedBytes(sizeof(BagTotalWeight));
+	RefreshCachedMultipliers();
+	MarkInventoryChanged(EInventoryChangeFlags::BagWeight);
+}
+
+void UInventoryComponent::ApplyBagWeightDelta(float WeightDelta)
+{
+	BagTotalWeight = BagEntries.Items.IsEmpty() ? 0.0f : FMath::Max(0.0f, BagTotalWeight + WeightDelta);
+	MARK_PROPERTY_DIRTY_FROM_NAME(UInventoryComponent, BagTotalWeight, this);
+	RefreshCachedMultipliers();
+}
+
+void UInventoryComponent::RefreshBalanceProfile()
+{
+	BalanceProfile = BalanceData ? BalanceData->GetCompiledProfile() : FInventoryBalanceProfile::GetDefault();
+	RefreshCachedMultipliers();
+}
+
+void UInventoryComponent::RefreshCachedMultipliers()
+{
+	const float VisibleBagWeight = GetBagTotalWeight();
+	CachedMovementSpeedMultiplier = BalanceProfile->GetMovementSpeedMultiplier(VisibleBagWeight);
+	CachedStaminaDrainMultiplier = BalanceProfile->GetStaminaDrainMultiplier(VisibleBagWeight);
+}
+
+float UInventoryComponent::GetMaxBagWeight() const
+{
+	return BalanceProfile->MaxBagWeight;
+}
+
+int32 UInventoryComponent::GetMaxBagStacks() const
+{
+	return BalanceProfile->MaxBagStacks;
+}
+
+float UInventoryComponent::GetLocateCooldownSeconds() const
+{
+	return BalanceProfile->LocateCooldownSeconds;
+}
+
+float UInventoryComponent::GetNearDistance() const
+{
+	return BalanceProfile->NearDistance;
+}
+
+float UInventoryComponent::GetMediumDistance() const
+{
+	return BalanceProfile->MediumDistance;
+}
+
+ELocatorDistanceBand UInventoryComponent::ResolveDistanceBandSquared(float DistanceSquared) const
+{
+	INVENTORY_SCOPE_CYCLE_COUNTER(STAT_InventoryResolveDistanceBand);
+
+	return BalanceProfile->ResolveDistanceBandSquared(DistanceSquared);
+}
+
+FVector UInventoryComponent::GetOwnerLocation() const
+{
+	const AActor* OwnerActor = GetOwner();
+	return OwnerActor ? OwnerActor->GetActorLocation() : FVector::ZeroVector;
+}
+
+int32 UInventoryComponent::GetOwnerPlayerId() const
+{
+	const AActor* OwnerActor = GetOwner();
+	const APlayerState* PlayerState = OwnerActor ? OwnerActor->GetPlayerState() : nullptr;
+	return PlayerState ? PlayerState->GetPlayerId() : INDEX_NONE;
+}
+
+bool UInventoryComponent::OwnsDroppedTool(const UDroppedToolRegistrySubsystem& ToolRegistry, const FGuid& ToolId) const
+{
+	const FTrackedTool* TrackedTool = ToolRegistry.FindTool(ToolId);
+	if (!TrackedTool)
+	{
+		return false;
+	}
+
+	if (ToolRegistry.FindReplicatingComponent(ToolId) == this)
+	{
+		return true;
+	}
+
+	const int32 OwnerPlayerId = GetOwnerPlayerId();
+	return OwnerPlayerId != INDEX_NONE && TrackedTool->OwnerPlayerId == OwnerPlayerId;
+}
+
+FUniqueNetIdRepl UInventoryComponent::GetOwnerUniqueNetId() const
+{
+	const AActor* OwnerActor = GetOwner();
+	const APlayerState* PlayerState = OwnerActor ? OwnerActor->GetPlayerState() : nullptr;
+	return PlayerState ? PlayerState->GetUniqueId() : FUniqueNetIdRepl();
+}
+
+void UInventoryComponent::TryRestoreTravelSnapshot()
+{
+	const UGameInstance* GameInstance = GetWorld() ? GetWorld()->GetGameInstance() : nullptr;
+	UInventoryTravelSubsystem* TravelSubsystem = GameInstance ? GameInstance->GetSubsystem<UInventoryTravelSubsystem>() : nullptr;
+	if (!TravelSubsystem || TravelSubsystem->GetNumPendingSnapshots() == 0)
+	{
+		return;
+	}
+
+	if (GetOwnerUniqueNetId().IsValid())
+	{
+		TravelSubsystem->RestoreInventory(*this);
+		return;
+	}
+
+	// Pawns usually begin play before they are possessed; retry once a controller brings the player state.
+	if (APawn* OwnerPawn = Cast<APawn>(GetOwner()))
+	{
+		OwnerPawn->ReceiveControllerChangedDelegate.AddUniqueDynamic(this, &UInventoryComponent::HandleOwnerControllerChanged);
+	}
+}
+
+void UInventoryComponent::HandleOwnerControllerChanged(APawn* Pawn, AController* OldController, AController* NewController)
+{
+	if (!NewController || !GetOwnerUniqueNetId().IsValid())
+	{
+		return;
+	}
+
+	Pawn->ReceiveControllerChangedDelegate.RemoveDynamic(this, &UInventoryComponent::HandleOwnerControllerChanged);
+	TryRestoreTravelSnapshot();
+}
+
+bool UInventoryComponent::IsLocateOnCooldown(float CurrentTimeSeconds) const
+{
+	const float Cooldown = GetLocateCooldownSeconds();
+	if (Cooldown <= 0.0f)
+	{
+		return false;
+	}
+
+	return LastLocateRequestTimeSeconds >= 0.0f && (CurrentTimeSeconds - LastLocateRequestTimeSeconds) < Cooldown;
+}
+
+void UInventoryComponent::UpdateLocateCooldown(float CurrentTimeSeconds)
+{
 	LastLocateRequestTimeSeconds = CurrentTimeSeconds;
 }
 
@@ -489,3 +1913,85 @@ bool UInventoryComponent::CanModifyInventory() const
 {
 	return GetOwner() && GetOwner()->HasAuthority();
 }
+
+void UInventoryComponent::RecordReliableRpcSent() const
+{
+	if (InventoryComponentStats::IsRemoteInventoryRpc(GetOwner()))
+	{
+		InventoryStats::RecordReliableRpcSent();
+	}
+}
+
+void UInventoryComponent::RecordReliableRpcReceived() const
+{
+	if (InventoryComponentStats::IsRemoteInventoryRpc(GetOwner()))
+	{
+		InventoryStats::RecordReliableRpcReceived();
+	}
+}
+
+void UInventoryComponent::RecordReplicatedBytes(uint32 NumBytes)
+{
+	EstimatedReplicatedBytes += NumBytes;
+	InventoryStats::RecordReplicatedBytes(NumBytes);
+}
+
+bool UInventoryComponent::ConsumeRpcBudget(EInventoryRpcFamily Family, float Cost)
+{
+	// Host-local calls have no connection and are never limited.
+	const UNetConnection* Connection = GetOwner() ? GetOwner()->GetNetConnection() : nullptr;
+	if (!Connection)
+	{
+		return true;
+	}
+
+	UInventoryRpcRateLimitSubsystem* RateLimiter = GetWorld() ? GetWorld()->GetSubsystem<UInventoryRpcRateLimitSubsystem>() : nullptr;
+	return !RateLimiter || RateLimiter->TryConsume(Connection, Family, BalanceProfile->GetRpcRateLimit(Family), Cost);
+}
+
+void UInventoryComponent::RecordInventoryEvent(EInventoryEventType Type, const UItemDefinitionDataAsset* ItemDefinition, int32 Quantity, int32 SlotIndex, const FGuid& ToolId, const FVector& WorldLocation) const
+{
+	const UWorld* World = GetWorld();
+	UInventoryEventLogSubsystem* EventLog = World ? World->GetSubsystem<UInventoryEventLogSubsystem>() : nullptr;
+	if (!EventLog)
+	{
+		return;
+	}
+
+	FInventoryEvent Event;
+	Event.TimeSeconds = World->GetTimeSeconds();
+	Event.PlayerId = GetOwnerPlayerId();
+	Event.Type = Type;
+	Event.SlotIndex = SlotIndex == INDEX_NONE ? MAX_uint8 : static_cast<uint8>(SlotIndex);
+	Event.ItemNetIndex = ItemDefinition ? UItemDefinitionRegistry::GetNetIndex(ItemDefinition) : UItemDefinitionRegistry::InvalidNetIndex;
+	Event.Quantity = Quantity;
+	Event.ToolId = ToolId;
+	Event.WorldLocation = FVector3f(WorldLocation);
+	EventLog->Record(Event);
+}
+
+bool UInventoryComponent::UsesIdleDormancy() const
+{
+	const AActor* OwnerActor = GetOwner();
+	return BalanceProfile->bOwnerDormantWhileIdle && OwnerActor && !OwnerActor->IsReplicatingMovement() && GetWorld();
+}
+
+void UInventoryComponent::WakeOwnerForReplication()
+{
+	AActor* OwnerActor = GetOwner();
+	if (UsesIdleDormancy())
+	{
+		OwnerActor->SetNetDormancy(DORM_Awake);
+		GetWorld()->GetTimerManager().SetTimer(IdleDormancyTimerHandle, this, &UInventoryComponent::EnterIdleDormancy, BalanceProfile->IdleDormancySeconds, false);
+	}
+
+	OwnerActor->ForceNetUpdate();
+}
+
+void UInventoryComponent::EnterIdleDormancy()
+{
+	if (UsesIdleDormancy())
+	{
+		GetOwner()->SetNetDormancy(DORM_DormantAll);
+	}
+}
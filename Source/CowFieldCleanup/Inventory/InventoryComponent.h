@@ -2,16 +2,34 @@
 
 #include "CoreMinimal.h"
 #include "Components/ActorComponent.h"
+#include "Engine/NetSerialization.h"
+#include "Engine/TimerHandle.h"
+#include "GameFramework/OnlineReplStructs.h"
+#include "DataAssets/InventoryBalanceProfile.h"
 #include "Inventory/InventoryTypes.h"
+#include "UObject/ObjectKey.h"
 #include "InventoryComponent.generated.h"
 
+class AController;
+class ALitterField;
+class APawn;
+class UDroppedToolRegistrySubsystem;
+class UToolLocatorTrackingSubsystem;
 class UInventoryBalanceDataAsset;
 class UItemDefinitionDataAsset;
+class UPrimitiveComponent;
+enum class EInventoryEventType : uint8;
 
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnBagWeightChanged, float, NewWeight);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE(FOnToolSlotsChanged);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE(FOnBagEntriesChanged);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_ThreeParams(FOnToolLocatorResult, const FGuid&, ToolId, ELocatorDistanceBand, DistanceBand, float, Distance);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnInventoryChanged, int32, ChangeMask);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnBagEntryChanged, const FBagItemEntry&, Entry, EInventoryEntryChange, Change);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnBagItemRefused, UItemDefinitionDataAsset*, ItemDefinition, int32, Quantity);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnTrackedToolChanged, const FTrackedTool&, TrackedTool, EInventoryEntryChange, Change);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnToolLocatorResults, const TArray<FToolLocatorResult>&, Results);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_FourParams(FOnLocatorTrackingUpdate, const FGuid&, ToolId, ELocatorDistanceBand, DistanceBand, float, DirectionYaw, float, Distance);
 
 UCLASS(ClassGroup=(Custom), meta=(BlueprintSpawnableComponent))
 class COWFIELDCLEANUP_API UInventoryComponent : public UActorComponent
@@ -36,6 +54,14 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Inventory|Movement")
 	float GetStaminaDrainMultiplier() const;
 
+	void SetBalanceData(UInventoryBalanceDataAsset* InBalanceData);
+
+	uint64 GetEstimatedReplicatedBytes() const;
+
+	// See FInventorySnapshot for the format; loading only works on the authority.
+	void SaveSnapshot(TArray<uint8>& OutBytes) const;
+	bool LoadSnapshot(TConstArrayView<uint8> Bytes);
+
 	UFUNCTION(BlueprintCallable, Category = "Inventory|Tools")
 	void RequestAddToolToSlot(UItemDefinitionDataAsset* ItemDefinition, const FGuid& ToolId, int32 SlotIndex);
 
@@ -48,18 +74,55 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Inventory|Bag")
 	void RequestRemoveBagItem(UItemDefinitionDataAsset* ItemDefinition, int32 Quantity);
 
+	// Picks one litter item up out of a field into the bag; the server checks range and that it is still there.
+	UFUNCTION(BlueprintCallable, Category = "Inventory|Bag")
+	void RequestPickupLitter(ALitterField* LitterField, int32 LitterIndex);
+
+	UFUNCTION(BlueprintCallable, Category = "Inventory")
+	void FlushInventoryBatch();
+
 	UFUNCTION(BlueprintCallable, Category = "Inventory|Locator")
 	void RequestLocateTool(const FGuid& ToolId);
 
+	// Locates up to MaxResults of the caller's dropped tools, nearest first; shares the single-tool locate cooldown.
 	UFUNCTION(BlueprintCallable, Category = "Inventory|Locator")
+	void RequestLocateAllMyTools(int32 MaxResults);
+
+	// Subscribes to continuous hot/cold updates for one dropped tool; replaces any previous subscription.
+	UFUNCTION(BlueprintCallable, Category = "Inventory|Locator")
+	void StartLocatorTracking(const FGuid& ToolId);
+
+	UFUNCTION(BlueprintCallable, Category = "Inventory|Locator")
+	void StopLocatorTracking();
+
+	// The tool is recorded as owned by this component's player; ids already owned by another player are rejected.
+	UFUNCTION(BlueprintCallable, Category = "Inventory|Locator")
+	void RegisterOwnDroppedTool(const FGuid& ToolId, const FVector& WorldLocation);
+
+	// Kept so existing Blueprint call sites still load; OwnerPlayerId must be INDEX_NONE or this component's player.
+	UFUNCTION(BlueprintCallable, Category = "Inventory|Locator", meta = (DeprecatedFunction, DeprecationMessage = "The owner is now always this component's player; use Register Own Dropped Tool."))
 	void RegisterDroppedTool(const FGuid& ToolId, int32 OwnerPlayerId, const FVector& WorldLocation);
 
 	UFUNCTION(BlueprintCallable, Category = "Inventory|Locator")
 	void UpdateDroppedToolLocation(const FGuid& ToolId, const FVector& WorldLocation);
 
+	UFUNCTION(BlueprintCallable, Category = "Inventory|Locator")
+	void SettleDroppedToolLocation(const FGuid& ToolId, const FVector& WorldLocation);
+
+	UFUNCTION(BlueprintCallable, Category = "Inventory|Locator")
+	void BindDroppedToolBody(const FGuid& ToolId, UPrimitiveComponent* Body);
+
 	UFUNCTION(BlueprintCallable, Category = "Inventory|Locator")
 	void RemoveDroppedTool(const FGuid& ToolId);
 
+	// Fires at most once per frame with the EInventoryChangeFlags gathered since the last dispatch.
+	UPROPERTY(BlueprintAssignable, Category = "Inventory")
+	FOnInventoryChanged OnInventoryChanged;
+
+	// Keeps OnBagWeightChanged, OnToolSlotsChanged and OnBagEntriesChanged firing alongside OnInventoryChanged.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Inventory")
+	bool bBroadcastLegacyDelegates = false;
+
 	UPROPERTY(BlueprintAssignable, Category = "Inventory")
 	FOnBagWeightChanged OnBagWeightChanged;
 
@@ -72,24 +135,95 @@ public:
 	UPROPERTY(BlueprintAssignable, Category = "Inventory")
 	FOnToolLocatorResult OnToolLocatorResult;
 
+	UPROPERTY(BlueprintAssignable, Category = "Inventory|Locator")
+	FOnToolLocatorResults OnToolLocatorResults;
+
+	UPROPERTY(BlueprintAssignable, Category = "Inventory|Bag")
+	FOnBagEntryChanged OnBagEntryChanged;
+
+	// The server refused an add because it would exceed the bag's weight or stack limit; fires on the owning client.
+	UPROPERTY(BlueprintAssignable, Category = "Inventory|Bag")
+	FOnBagItemRefused OnBagItemRefused;
+
+	UPROPERTY(BlueprintAssignable, Category = "Inventory|Locator")
+	FOnTrackedToolChanged OnTrackedToolChanged;
+
+	// Band or direction changes from locator tracking; Unknown band means tracking ended.
+	UPROPERTY(BlueprintAssignable, Category = "Inventory|Locator")
+	FOnLocatorTrackingUpdate OnLocatorTrackingUpdate;
+
 protected:
 	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
 	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
 
 private:
+	friend struct FBagItemEntry;
+	friend struct FTrackedTool;
+	friend class UToolLocatorTrackingSubsystem;
+	friend class UInventoryTravelSubsystem;
+	friend struct FInventorySnapshot;
+	// Test stand-in for the owning connection, in InventoryPerformanceTests.cpp.
+	friend class FInventoryReplicationLoopback;
+
+	void HandleBagEntryReplicated(const FBagItemEntry& Entry, EInventoryEntryChange Change);
+	void HandleTrackedToolReplicated(const FTrackedTool& TrackedTool, EInventoryEntryChange Change);
+	void UpsertTrackedToolMirror(const FTrackedTool& TrackedTool);
+	void RemoveTrackedToolMirror(const FGuid& ToolId);
+	UDroppedToolRegistrySubsystem* GetToolRegistry() const;
+	UToolLocatorTrackingSubsystem* GetLocatorTracking() const;
+	void ApplyDroppedToolLocation(const FGuid& ToolId, const FVector& WorldLocation);
+	bool TryStreamDroppedToolLocation(const FGuid& ToolId, const FVector& WorldLocation);
+	void StreamAwakeDroppedToolBodies();
+	bool HasAwakeDroppedToolBodies() const;
 	void InitializeToolSlots();
+	void QueueBatchOp(EInventoryBatchOpType Type, UItemDefinitionDataAsset* ItemDefinition, const FGuid& ToolId, int32 Argument);
+	void MarkInventoryChanged(EInventoryChangeFlags ChangeMask);
+	void DispatchInventoryChanges();
+	bool IsPredicting() const;
+	void RequestReconcile();
+	void ReconcilePredictedOps();
+	void UpdatePredictedView();
+	void ApplyPredictedOp(const FInventoryBatchOp& Op);
+	void ApplyToolSlot(int32 SlotIndex, UItemDefinitionDataAsset* ItemDefinition, const FGuid& ToolId);
+	// Server-side add after the RPC budget has been paid; returns the quantity that went into the bag.
+	int32 TryAddBagItem(UItemDefinitionDataAsset* ItemDefinition, int32 Quantity);
+	bool CanFitInBag(const UItemDefinitionDataAsset* ItemDefinition, int32 ExistingQuantity, int32 Quantity, float CurrentWeight, int32 CurrentStacks) const;
+	int32 CountBagStacks(TConstArrayView<FBagItemEntry> Entries) const;
+	void NotifyBagItemRefused(UItemDefinitionDataAsset* ItemDefinition, int32 Quantity);
+	void ApplyAddBagItem(UItemDefinitionDataAsset* ItemDefinition, int32 Quantity);
+	bool ApplyRemoveBagItem(UItemDefinitionDataAsset* ItemDefinition, int32 Quantity);
+	int32 GetBagQuantity(const UItemDefinitionDataAsset* ItemDefinition) const;
 	void RecalculateBagWeight();
-	float GetCurveValueSafe(const UCurveFloat* Curve) const;
+	void PushTeamProgressDelta(const UItemDefinitionDataAsset* ItemDefinition, int32 QuantityDelta);
+	void ApplyBagWeightDelta(float WeightDelta);
+	void RefreshBalanceProfile();
+	void RefreshCachedMultipliers();
 	float GetMaxBagWeight() const;
+	int32 GetMaxBagStacks() const;
 	float GetLocateCooldownSeconds() const;
 	float GetNearDistance() const;
 	float GetMediumDistance() const;
-	ELocatorDistanceBand ResolveDistanceBand(float Distance) const;
+	ELocatorDistanceBand ResolveDistanceBandSquared(float DistanceSquared) const;
 	FVector GetOwnerLocation() const;
 	int32 GetOwnerPlayerId() const;
+
+	// True when this component replicates the tool's record or belongs to the player that dropped it.
+	bool OwnsDroppedTool(const UDroppedToolRegistrySubsystem& ToolRegistry, const FGuid& ToolId) const;
+	FUniqueNetIdRepl GetOwnerUniqueNetId() const;
+	void TryRestoreTravelSnapshot();
 	bool IsLocateOnCooldown(float CurrentTimeSeconds) const;
 	void UpdateLocateCooldown(float CurrentTimeSeconds);
 	bool CanModifyInventory() const;
+	void RecordReliableRpcSent() const;
+	void RecordReliableRpcReceived() const;
+	void RecordReplicatedBytes(uint32 NumBytes);
+	bool ConsumeRpcBudget(EInventoryRpcFamily Family, float Cost = 1.0f);
+	void RecordInventoryEvent(EInventoryEventType Type, const UItemDefinitionDataAsset* ItemDefinition = nullptr, int32 Quantity = 0, int32 SlotIndex = INDEX_NONE, const FGuid& ToolId = FGuid(), const FVector& WorldLocation = FVector::ZeroVector) const;
+	bool UsesIdleDormancy() const;
+	void WakeOwnerForReplication();
+	void EnterIdleDormancy();
 
 	UFUNCTION(Server, Reliable)
 	void ServerAddToolToSlot(UItemDefinitionDataAsset* ItemDefinition, const FGuid& ToolId, int32 SlotIndex);
@@ -97,17 +231,29 @@ private:
 	UFUNCTION(Server, Reliable)
 	void ServerRemoveToolFromSlot(int32 SlotIndex);
 
-	UFUNCTION(Server, Reliable)
+	UFUNCTION(Server, Reliable, WithValidation)
 	void ServerAddBagItem(UItemDefinitionDataAsset* ItemDefinition, int32 Quantity);
 
-	UFUNCTION(Server, Reliable)
+	UFUNCTION(Server, Reliable, WithValidation)
 	void ServerRemoveBagItem(UItemDefinitionDataAsset* ItemDefinition, int32 Quantity);
 
-	UFUNCTION(Server, Reliable)
-	void ServerRegisterDroppedTool(const FGuid& ToolId, int32 OwnerPlayerId, const FVector& WorldLocation);
+	UFUNCTION(Server, Reliable, WithValidation)
+	void ServerPickupLitter(ALitterField* LitterField, int32 LitterIndex);
 
-	UFUNCTION(Server, Reliable)
-	void ServerUpdateDroppedToolLocation(const FGuid& ToolId, const FVector& WorldLocation);
+	UFUNCTION(Client, Reliable)
+	void ClientBagItemRefused(UItemDefinitionDataAsset* ItemDefinition, int32 Quantity);
+
+	UFUNCTION(Server, Reliable, WithValidation)
+	void ServerApplyInventoryBatch(const TArray<FInventoryBatchOp>& Ops, uint32 BatchSequence);
+
+	UFUNCTION(Server, Reliable, WithValidation)
+	void ServerRegisterDroppedTool(const FGuid& ToolId, const FVector& WorldLocation);
+
+	UFUNCTION(Server, Reliable, WithValidation)
+	void ServerUpdateDroppedToolLocation(const FGuid& ToolId, const FVector_NetQuantize10& WorldLocation);
+
+	UFUNCTION(Server, Unreliable, WithValidation)
+	void ServerStreamDroppedToolLocation(const FGuid& ToolId, const FVector_NetQuantize10& WorldLocation);
 
 	UFUNCTION(Server, Reliable)
 	void ServerRemoveDroppedTool(const FGuid& ToolId);
@@ -116,7 +262,22 @@ private:
 	void ServerRequestLocateTool(const FGuid& ToolId);
 
 	UFUNCTION(Client, Reliable)
-	void ClientReceiveToolLocation(const FGuid& ToolId, const FVector& Direction, ELocatorDistanceBand DistanceBand, float Distance);
+	void ClientReceiveToolLocation(const FToolLocatorResult& Result);
+
+	UFUNCTION(Server, Reliable, WithValidation)
+	void ServerRequestLocateAllTools(uint8 MaxResults);
+
+	UFUNCTION(Client, Reliable)
+	void ClientReceiveToolLocations(const TArray<FToolLocatorResult>& Results);
+
+	UFUNCTION(Server, Reliable)
+	void ServerStartLocatorTracking(const FGuid& ToolId);
+
+	UFUNCTION(Server, Reliable)
+	void ServerStopLocatorTracking();
+
+	UFUNCTION(Client, Unreliable)
+	void ClientReceiveLocatorTracking(const FGuid& ToolId, ELocatorDistanceBand DistanceBand, uint8 DirectionSector, uint16 DistanceMeters);
 
 	UFUNCTION()
 	void OnRep_ToolSlots();
@@ -130,6 +291,18 @@ private:
 	UFUNCTION()
 	void OnRep_TrackedTools();
 
+	UFUNCTION()
+	void OnRep_LastProcessedBatchSequence();
+
+	UFUNCTION()
+	void HandleOwnerControllerChanged(APawn* Pawn, AController* OldController, AController* NewController);
+
+	UFUNCTION()
+	void HandleDroppedToolBodyWake(UPrimitiveComponent* WakingComponent, FName BoneName);
+
+	UFUNCTION()
+	void HandleDroppedToolBodySleep(UPrimitiveComponent* SleepingComponent, FName BoneName);
+
 	UPROPERTY(EditDefaultsOnly, Category = "Inventory")
 	TObjectPtr<UInventoryBalanceDataAsset> BalanceData;
 
@@ -137,13 +310,72 @@ private:
 	TArray<FToolSlotEntry> ToolSlots;
 
 	UPROPERTY(ReplicatedUsing = OnRep_BagEntries)
-	TArray<FBagItemEntry> BagEntries;
+	FBagItemArray BagEntries;
 
 	UPROPERTY(ReplicatedUsing = OnRep_BagTotalWeight)
 	float BagTotalWeight = 0.0f;
 
+	// Server-side running total of GetNumStacks over the bag, checked against MaxBagStacks.
+	int32 BagStackCount = 0;
+
 	UPROPERTY(ReplicatedUsing = OnRep_TrackedTools)
-	TArray<FTrackedTool> TrackedTools;
+	FTrackedToolArray TrackedTools;
+
+	UPROPERTY(ReplicatedUsing = OnRep_LastProcessedBatchSequence)
+	uint32 LastProcessedBatchSequence = 0;
+
+	struct FPredictedInventoryOp
+	{
+		uint32 Sequence = 0;
+		FInventoryBatchOp Op;
+	};
+
+	static constexpr int32 MaxInventoryBatchOps = 64;
+	static constexpr int32 MaxLocateAllResults = 16;
+
+	TArray<FInventoryBatchOp> PendingBatchOps;
+	uint32 LastSentBatchSequence = 0;
+
+	TArray<FPredictedInventoryOp> PredictedOps;
+	TArray<FToolSlotEntry> PredictedToolSlots;
+	TArray<FBagItemEntry> PredictedBagEntries;
+	float PredictedBagWeight = 0.0f;
+	int32 PredictedBagStacks = 0;
+	bool bHasPredictedView = false;
+	TArray<FToolSlotEntry> PreviousToolSlotsScratch;
+	TArray<FBagItemEntry> PreviousBagEntriesScratch;
+
+	EInventoryChangeFlags PendingChangeMask = EInventoryChangeFlags::None;
+	bool bReconcilePending = false;
+
+	TSharedRef<const FInventoryBalanceProfile> BalanceProfile = FInventoryBalanceProfile::GetDefault();
+	float CachedMovementSpeedMultiplier = 1.0f;
+	float CachedStaminaDrainMultiplier = 1.0f;
+
+#if WITH_EDITOR
+	FDelegateHandle BalanceProfileRebuiltHandle;
+#endif
+
+	TMap<TObjectKey<UItemDefinitionDataAsset>, int32> BagIndexByDefinition;
+	TMap<FGuid, int32> TrackedToolIndexById;
+
+	struct FDroppedToolStream
+	{
+		TWeakObjectPtr<UPrimitiveComponent> Body;
+		FVector LastSentLocation = FVector::ZeroVector;
+		double LastRefillTimeSeconds = 0.0;
+		float SendTokens = 0.0f;
+		bool bHasSent = false;
+		bool bBodyAwake = false;
+	};
+
+	TMap<FGuid, FDroppedToolStream> DroppedToolStreams;
 
 	float LastLocateRequestTimeSeconds = -1.0f;
+	FTimerHandle IdleDormancyTimerHandle;
+
+	// Player id this bag's contents are currently counted under in the team cleanup progress.
+	int32 TeamProgressPlayerId = INDEX_NONE;
+
+	uint64 EstimatedReplicatedBytes = 0;
 };
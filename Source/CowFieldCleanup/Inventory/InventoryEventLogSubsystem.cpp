@@ -0,0 +1,162 @@
+#include "Inventory/InventoryEventLogSubsystem.h"
+
+#include "Async/Async.h"
+#include "CowFieldCleanup.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+#include "Inventory/InventoryStats.h"
+#include "Misc/DateTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+DECLARE_CYCLE_STAT(TEXT("EventLogSnapshot"), STAT_InventoryEventLogSnapshot, STATGROUP_Inventory);
+
+static TAutoConsoleVariable<int32> CVarCowFieldCleanupEventLogCapacity(
+	TEXT("CowFieldCleanup.Inventory.EventLogCapacity"),
+	16384,
+	TEXT("Number of inventory events kept for highlight replays, rounded up to a power of two. Read when a server world starts."));
+
+namespace InventoryEventLog
+{
+	struct FFileHeader
+	{
+		uint32 Magic = UInventoryEventLogSubsystem::FileMagic;
+		uint16 Version = UInventoryEventLogSubsystem::FileVersion;
+		uint16 EventSize = sizeof(FInventoryEvent);
+		uint32 NumEvents = 0;
+		uint32 NumDroppedEvents = 0;
+	};
+
+	static void SaveClipCommand(const TArray<FString>& Args, UWorld* World)
+	{
+		UInventoryEventLogSubsystem* EventLog = World ? World->GetSubsystem<UInventoryEventLogSubsystem>() : nullptr;
+		if (!EventLog)
+		{
+			return;
+		}
+
+		const float ClipSeconds = Args.Num() > 0 ? FCString::Atof(*Args[0]) : 30.0f;
+		const FString FilePath = EventLog->SaveEventClip(ClipSeconds);
+		UE_LOG(LogCowFieldCleanup, Display, TEXT("Inventory event clip: %s"), FilePath.IsEmpty() ? TEXT("no events") : *FilePath);
+	}
+
+	static FAutoConsoleCommandWithWorldAndArgs SaveClipConsoleCommand(
+		TEXT("Inventory.SaveEventClip"),
+		TEXT("Writes the inventory events from the last N seconds (default 30) to Saved/Highlights."),
+		FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(&SaveClipCommand));
+}
+
+bool UInventoryEventLogSubsystem::ShouldCreateSubsystem(UObject* Outer) const
+{
+	const UWorld* World = Cast<UWorld>(Outer);
+	return World && World->IsGameWorld() && World->GetNetMode() != NM_Client && Super::ShouldCreateSubsystem(Outer);
+}
+
+void UInventoryEventLogSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	LLM_SCOPE_BYTAG(Inventory);
+
+	const uint32 Capacity = FMath::RoundUpToPowerOfTwo(static_cast<uint32>(FMath::Max(CVarCowFieldCleanupEventLogCapacity.GetValueOnGameThread(), 16)));
+	Events.SetNumZeroed(Capacity);
+	CapacityMask = Capacity - 1;
+	NumRecordedEvents = 0;
+}
+
+void UInventoryEventLogSubsystem::Deinitialize()
+{
+	for (TFuture<bool>& PendingWrite : PendingWrites)
+	{
+		PendingWrite.Wait();
+	}
+	PendingWrites.Reset();
+	Events.Empty();
+
+	Super::Deinitialize();
+}
+
+void UInventoryEventLogSubsystem::Record(const FInventoryEvent& Event)
+{
+	Events[static_cast<int32>(NumRecordedEvents & CapacityMask)] = Event;
+	++NumRecordedEvents;
+}
+
+FString UInventoryEventLogSubsystem::SaveEventLog(const FString& Label)
+{
+	return WriteEventsAsync(Label.IsEmpty() ? TEXT("Match") : Label, -UE_BIG_NUMBER);
+}
+
+FString UInventoryEventLogSubsystem::SaveEventClip(float ClipSeconds)
+{
+	const float CurrentTimeSeconds = GetWorld()->GetTimeSeconds();
+	return WriteEventsAsync(TEXT("Clip"), CurrentTimeSeconds - FMath::Max(0.0f, ClipSeconds));
+}
+
+int32 UInventoryEventLogSubsystem::GetCapacity() const
+{
+	return Events.Num();
+}
+
+int32 UInventoryEventLogSubsystem::GetNumBufferedEvents() const
+{
+	return static_cast<int32>(FMath::Min<uint64>(NumRecordedEvents, Events.Num()));
+}
+
+uint64 UInventoryEventLogSubsystem::GetNumRecordedEvents() const
+{
+	return NumRecordedEvents;
+}
+
+FString UInventoryEventLogSubsystem::WriteEventsAsync(const FString& Label, float MinTimeSeconds)
+{
+	INVENTORY_SCOPE_CYCLE_COUNTER(STAT_InventoryEventLogSnapshot);
+
+	PendingWrites.RemoveAll([](const TFuture<bool>& PendingWrite)
+	{
+		return PendingWrite.IsReady();
+	});
+
+	// Events are recorded in time order, so walk back from the newest to find where the window starts.
+	const int32 NumBuffered = GetNumBufferedEvents();
+	int32 NumInWindow = 0;
+	while (NumInWindow < NumBuffered && Events[static_cast<int32>((NumRecordedEvents - NumInWindow - 1) & CapacityMask)].TimeSeconds >= MinTimeSeconds)
+	{
+		++NumInWindow;
+	}
+
+	if (NumInWindow == 0)
+	{
+		return FString();
+	}
+
+	InventoryEventLog::FFileHeader Header;
+	Header.NumEvents = static_cast<uint32>(NumInWindow);
+	Header.NumDroppedEvents = static_cast<uint32>(FMath::Min<uint64>(NumRecordedEvents - NumBuffered, MAX_uint32));
+
+	// One contiguous copy on the game thread; the ring may wrap, so it is copied in at most two spans.
+	TArray<uint8> FileBytes;
+	FileBytes.SetNumUninitialized(sizeof(Header) + NumInWindow * sizeof(FInventoryEvent));
+	FMemory::Memcpy(FileBytes.GetData(), &Header, sizeof(Header));
+
+	const int32 FirstIndex = static_cast<int32>((NumRecordedEvents - NumInWindow) & CapacityMask);
+	const int32 NumBeforeWrap = FMath::Min(NumInWindow, Events.Num() - FirstIndex);
+	uint8* EventBytes = FileBytes.GetData() + sizeof(Header);
+	FMemory::Memcpy(EventBytes, &Events[FirstIndex], NumBeforeWrap * sizeof(FInventoryEvent));
+	if (NumBeforeWrap < NumInWindow)
+	{
+		FMemory::Memcpy(EventBytes + NumBeforeWrap * sizeof(FInventoryEvent), Events.GetData(), (NumInWindow - NumBeforeWrap) * sizeof(FInventoryEvent));
+	}
+
+	const FString FilePath = FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("Highlights"),
+		FString::Printf(TEXT("InventoryEvents_%s_%s.bin"), *Label, *FDateTime::Now().ToString(TEXT("%Y%m%d-%H%M%S-%s"))));
+
+	PendingWrites.Add(Async(EAsyncExecution::ThreadPool, [FilePath, FileBytes = MoveTemp(FileBytes)]()
+	{
+		const bool bSaved = FFileHelper::SaveArrayToFile(FileBytes, *FilePath);
+		UE_CLOG(!bSaved, LogCowFieldCleanup, Warning, TEXT("Failed to write inventory event log %s."), *FilePath);
+		return bSaved;
+	}));
+
+	return FilePath;
+}
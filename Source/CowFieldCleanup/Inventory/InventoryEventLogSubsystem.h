@@ -0,0 +1,72 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Async/Future.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "InventoryEventLogSubsystem.generated.h"
+
+enum class EInventoryEventType : uint8
+{
+	BagItemAdded,
+	BagItemRemoved,
+	ToolSlotChanged,
+	ToolDropped,
+	ToolMoved,
+	ToolRemoved,
+	ToolLocated,
+	AllToolsLocated
+};
+
+// One applied inventory change. Written to disk as-is, so keep it trivially copyable and bump
+// UInventoryEventLogSubsystem::FileVersion when the layout changes.
+struct FInventoryEvent
+{
+	float TimeSeconds = 0.0f;
+	int32 PlayerId = INDEX_NONE;
+	EInventoryEventType Type = EInventoryEventType::BagItemAdded;
+	uint8 SlotIndex = MAX_uint8;
+	uint16 ItemNetIndex = MAX_uint16;
+	int32 Quantity = 0;
+	FGuid ToolId;
+	FVector3f WorldLocation = FVector3f::ZeroVector;
+};
+
+static_assert(std::is_trivially_copyable_v<FInventoryEvent>, "FInventoryEvent is written to disk with a raw copy.");
+
+// Server-side fixed-capacity ring of FInventoryEvent for highlight replays. Recording never allocates;
+// saving copies the ring once on the game thread and writes the file on a worker.
+UCLASS()
+class COWFIELDCLEANUP_API UInventoryEventLogSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	static constexpr uint32 FileMagic = 0x43464945; // "CFIE"
+	static constexpr uint16 FileVersion = 1;
+
+	virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+
+	void Record(const FInventoryEvent& Event);
+
+	// Writes every buffered event, e.g. at match end. Returns the file path, or an empty string if nothing was buffered.
+	UFUNCTION(BlueprintCallable, Category = "Inventory|Replay")
+	FString SaveEventLog(const FString& Label);
+
+	// "Clip that": writes the events from the last ClipSeconds.
+	UFUNCTION(BlueprintCallable, Category = "Inventory|Replay")
+	FString SaveEventClip(float ClipSeconds);
+
+	int32 GetCapacity() const;
+	int32 GetNumBufferedEvents() const;
+	uint64 GetNumRecordedEvents() const;
+
+private:
+	FString WriteEventsAsync(const FString& Label, float MinTimeSeconds);
+
+	TArray<FInventoryEvent> Events;
+	uint32 CapacityMask = 0;
+	uint64 NumRecordedEvents = 0;
+	TArray<TFuture<bool>> PendingWrites;
+};
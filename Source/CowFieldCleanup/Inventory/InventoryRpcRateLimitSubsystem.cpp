@@ -0,0 +1,81 @@
+#include "Inventory/InventoryRpcRateLimitSubsystem.h"
+
+#include "CowFieldCleanup.h"
+#include "Engine/NetConnection.h"
+#include "Engine/World.h"
+#include "Inventory/InventoryStats.h"
+
+namespace InventoryRpcRateLimit
+{
+	static constexpr double PurgeIntervalSeconds = 10.0;
+}
+
+void UInventoryRpcRateLimitSubsystem::Deinitialize()
+{
+	BucketsByConnection.Reset();
+
+	Super::Deinitialize();
+}
+
+bool UInventoryRpcRateLimitSubsystem::TryConsume(const UNetConnection* Connection, EInventoryRpcFamily Family, const FInventoryRpcRateLimit& RateLimit, float Cost)
+{
+	if (!Connection || RateLimit.TokensPerSecond <= 0.0f)
+	{
+		return true;
+	}
+
+	const double CurrentTimeSeconds = GetWorld()->GetRealTimeSeconds();
+	if (CurrentTimeSeconds - LastPurgeSeconds >= InventoryRpcRateLimit::PurgeIntervalSeconds)
+	{
+		PurgeClosedConnections(CurrentTimeSeconds);
+	}
+
+	FConnectionBuckets& ConnectionBuckets = BucketsByConnection.FindOrAdd(Connection);
+	ConnectionBuckets.Connection = Connection;
+
+	FTokenBucket& Bucket = ConnectionBuckets.Buckets[static_cast<int32>(Family)];
+	if (!Bucket.bInitialized)
+	{
+		Bucket.Tokens = RateLimit.Burst;
+		Bucket.bInitialized = true;
+	}
+	else
+	{
+		const float RefilledTokens = static_cast<float>(CurrentTimeSeconds - Bucket.LastRefillSeconds) * RateLimit.TokensPerSecond;
+		Bucket.Tokens = FMath::Min(RateLimit.Burst, Bucket.Tokens + RefilledTokens);
+	}
+	Bucket.LastRefillSeconds = CurrentTimeSeconds;
+
+	// A call larger than the burst (e.g. a full batch) is admitted from a full bucket rather than never.
+	const float ClampedCost = FMath::Min(Cost, RateLimit.Burst);
+	if (Bucket.Tokens < ClampedCost)
+	{
+		++NumRejected[static_cast<int32>(Family)];
+		InventoryStats::RecordRpcRejected();
+		UE_LOG(LogCowFieldCleanup, Verbose, TEXT("Rate limited %s RPC from %s."), *UEnum::GetValueAsString(Family), *Connection->LowLevelGetRemoteAddress(true));
+		return false;
+	}
+
+	Bucket.Tokens -= ClampedCost;
+	return true;
+}
+
+uint64 UInventoryRpcRateLimitSubsystem::GetNumRejected(EInventoryRpcFamily Family) const
+{
+	check(Family < EInventoryRpcFamily::Num);
+	return NumRejected[static_cast<int32>(Family)];
+}
+
+void UInventoryRpcRateLimitSubsystem::PurgeClosedConnections(double CurrentTimeSeconds)
+{
+	LastPurgeSeconds = CurrentTimeSeconds;
+
+	for (auto It = BucketsByConnection.CreateIterator(); It; ++It)
+	{
+		const UNetConnection* Connection = It.Value().Connection.Get();
+		if (!Connection || Connection->GetConnectionState() == USOCK_Closed)
+		{
+			It.RemoveCurrent();
+		}
+	}
+}
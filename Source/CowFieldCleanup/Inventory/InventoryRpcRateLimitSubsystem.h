@@ -0,0 +1,44 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Inventory/InventoryTypes.h"
+#include "UObject/ObjectKey.h"
+#include "InventoryRpcRateLimitSubsystem.generated.h"
+
+class UNetConnection;
+
+// Per-connection token buckets for inventory server RPCs, one per EInventoryRpcFamily. Checked at the top of
+// each RPC so a flooding client is turned away before any inventory work runs on the host.
+UCLASS()
+class COWFIELDCLEANUP_API UInventoryRpcRateLimitSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Deinitialize() override;
+
+	bool TryConsume(const UNetConnection* Connection, EInventoryRpcFamily Family, const FInventoryRpcRateLimit& RateLimit, float Cost);
+
+	uint64 GetNumRejected(EInventoryRpcFamily Family) const;
+
+private:
+	struct FTokenBucket
+	{
+		float Tokens = 0.0f;
+		double LastRefillSeconds = 0.0;
+		bool bInitialized = false;
+	};
+
+	struct FConnectionBuckets
+	{
+		TWeakObjectPtr<const UNetConnection> Connection;
+		FTokenBucket Buckets[static_cast<int32>(EInventoryRpcFamily::Num)];
+	};
+
+	void PurgeClosedConnections(double CurrentTimeSeconds);
+
+	TMap<TObjectKey<UNetConnection>, FConnectionBuckets> BucketsByConnection;
+	uint64 NumRejected[static_cast<int32>(EInventoryRpcFamily::Num)] = {};
+	double LastPurgeSeconds = 0.0;
+};
@@ -0,0 +1,283 @@
+#include "Inventory/InventorySnapshot.h"
+
+#include "CowFieldCleanup.h"
+#include "DataAssets/ItemDefinitionDataAsset.h"
+#include "GameFramework/Actor.h"
+#include "Inventory/DroppedToolRegistrySubsystem.h"
+#include "Inventory/InventoryComponent.h"
+#include "Inventory/InventoryStats.h"
+#include "Inventory/ItemDefinitionRegistry.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+DECLARE_CYCLE_STAT(TEXT("SnapshotSave"), STAT_InventorySnapshotSave, STATGROUP_Inventory);
+DECLARE_CYCLE_STAT(TEXT("SnapshotLoad"), STAT_InventorySnapshotLoad, STATGROUP_Inventory);
+
+namespace InventorySnapshotFormat
+{
+	static constexpr uint32 Magic = 0x43464953; // "CFIS"
+	static constexpr uint32 EmptySlotHandle = 0;
+
+	struct FParsedSlot
+	{
+		uint32 ToolHandle = EmptySlotHandle;
+		uint16 ItemNetIndex = UItemDefinitionRegistry::InvalidNetIndex;
+	};
+
+	struct FParsedBagEntry
+	{
+		uint16 ItemNetIndex = UItemDefinitionRegistry::InvalidNetIndex;
+		uint32 Quantity = 0;
+	};
+
+	struct FParsedTrackedTool
+	{
+		uint32 OwnerPlayerIdPlusOne = 0;
+		FVector3f WorldLocation = FVector3f::ZeroVector;
+		uint8 bIsDropped = 0;
+	};
+
+	// Every element costs at least one byte, so a count larger than the buffer means the snapshot is corrupt.
+	static bool ReadCount(FArchive& Ar, int32 MaxCount, uint32& OutCount)
+	{
+		OutCount = 0;
+		Ar.SerializeIntPacked(OutCount);
+		return !Ar.IsError() && OutCount <= static_cast<uint32>(MaxCount);
+	}
+}
+
+void FInventorySnapshot::Save(const UInventoryComponent& Inventory, TArray<uint8>& OutBytes)
+{
+	INVENTORY_SCOPE_CYCLE_COUNTER(STAT_InventorySnapshotSave);
+
+	using namespace InventorySnapshotFormat;
+
+	OutBytes.Reset();
+	FMemoryWriter Writer(OutBytes);
+
+	uint32 SnapshotMagic = Magic;
+	uint8 Version = static_cast<uint8>(EVersion::Latest);
+	Writer << SnapshotMagic;
+	Writer << Version;
+
+	// Tracked tools take the first handles in mirror order; slot tools that are not tracked are appended.
+	const TArray<FTrackedTool>& TrackedTools = Inventory.TrackedTools.Items;
+	TArray<FGuid, TInlineAllocator<32>> ToolHandles;
+	ToolHandles.Reserve(TrackedTools.Num() + Inventory.ToolSlots.Num());
+	for (const FTrackedTool& TrackedTool : TrackedTools)
+	{
+		ToolHandles.Add(TrackedTool.ToolId);
+	}
+
+	TArray<uint32, TInlineAllocator<16>> SlotHandles;
+	SlotHandles.Reserve(Inventory.ToolSlots.Num());
+	for (const FToolSlotEntry& Slot : Inventory.ToolSlots)
+	{
+		uint32 SlotHandle = EmptySlotHandle;
+		if (Slot.bOccupied)
+		{
+			const int32* TrackedIndex = Inventory.TrackedToolIndexById.Find(Slot.ToolId);
+			SlotHandle = 1 + static_cast<uint32>(TrackedIndex ? *TrackedIndex : ToolHandles.Add(Slot.ToolId));
+		}
+		SlotHandles.Add(SlotHandle);
+	}
+
+	uint32 NumToolHandles = ToolHandles.Num();
+	Writer.SerializeIntPacked(NumToolHandles);
+	for (FGuid& ToolId : ToolHandles)
+	{
+		Writer << ToolId;
+	}
+
+	uint32 NumSlots = Inventory.ToolSlots.Num();
+	Writer.SerializeIntPacked(NumSlots);
+	for (int32 SlotIndex = 0; SlotIndex < Inventory.ToolSlots.Num(); ++SlotIndex)
+	{
+		Writer.SerializeIntPacked(SlotHandles[SlotIndex]);
+		if (SlotHandles[SlotIndex] != EmptySlotHandle)
+		{
+			uint16 ItemNetIndex = UItemDefinitionRegistry::GetNetIndex(Inventory.ToolSlots[SlotIndex].ItemDefinition);
+			Writer << ItemNetIndex;
+		}
+	}
+
+	uint32 NumBagEntries = Inventory.BagEntries.Items.Num();
+	Writer.SerializeIntPacked(NumBagEntries);
+	for (const FBagItemEntry& Entry : Inventory.BagEntries.Items)
+	{
+		uint16 ItemNetIndex = UItemDefinitionRegistry::GetNetIndex(Entry.ItemDefinition);
+		uint32 Quantity = static_cast<uint32>(FMath::Max(0, Entry.Quantity));
+		Writer << ItemNetIndex;
+		Writer.SerializeIntPacked(Quantity);
+	}
+
+	uint32 NumTrackedTools = TrackedTools.Num();
+	Writer.SerializeIntPacked(NumTrackedTools);
+	for (const FTrackedTool& TrackedTool : TrackedTools)
+	{
+		uint32 OwnerPlayerIdPlusOne = static_cast<uint32>(FMath::Max(0, TrackedTool.OwnerPlayerId + 1));
+		FVector3f WorldLocation(TrackedTool.WorldLocation);
+		uint8 bIsDropped = TrackedTool.bIsDropped ? 1 : 0;
+		Writer.SerializeIntPacked(OwnerPlayerIdPlusOne);
+		Writer << WorldLocation;
+		Writer << bIsDropped;
+	}
+}
+
+bool FInventorySnapshot::Load(UInventoryComponent& Inventory, TConstArrayView<uint8> Bytes)
+{
+	INVENTORY_SCOPE_CYCLE_COUNTER(STAT_InventorySnapshotLoad);
+
+	using namespace InventorySnapshotFormat;
+
+	if (!Inventory.CanModifyInventory())
+	{
+		return false;
+	}
+
+	FMemoryReaderView Reader(Bytes);
+
+	uint32 SnapshotMagic = 0;
+	uint8 Version = 0;
+	Reader << SnapshotMagic;
+	Reader << Version;
+	if (Reader.IsError() || SnapshotMagic != Magic || Version == 0 || Version > static_cast<uint8>(EVersion::Latest))
+	{
+		UE_LOG(LogCowFieldCleanup, Warning, TEXT("Rejected inventory snapshot for %s: bad header (version %u)."), *GetNameSafe(Inventory.GetOwner()), Version);
+		return false;
+	}
+
+	// Everything is parsed into staging arrays first so a truncated snapshot never half-applies.
+	uint32 NumToolHandles = 0;
+	if (!ReadCount(Reader, Bytes.Num() / static_cast<int32>(sizeof(FGuid)), NumToolHandles))
+	{
+		return false;
+	}
+
+	TArray<FGuid, TInlineAllocator<32>> ToolHandles;
+	ToolHandles.SetNum(NumToolHandles);
+	for (FGuid& ToolId : ToolHandles)
+	{
+		Reader << ToolId;
+	}
+
+	uint32 NumSlots = 0;
+	if (!ReadCount(Reader, Bytes.Num(), NumSlots))
+	{
+		return false;
+	}
+
+	TArray<FParsedSlot, TInlineAllocator<16>> ParsedSlots;
+	ParsedSlots.SetNum(NumSlots);
+	for (FParsedSlot& ParsedSlot : ParsedSlots)
+	{
+		Reader.SerializeIntPacked(ParsedSlot.ToolHandle);
+		if (ParsedSlot.ToolHandle != EmptySlotHandle)
+		{
+			Reader << ParsedSlot.ItemNetIndex;
+			if (ParsedSlot.ToolHandle > NumToolHandles)
+			{
+				Reader.SetError();
+			}
+		}
+	}
+
+	uint32 NumBagEntries = 0;
+	if (Reader.IsError() || !ReadCount(Reader, Bytes.Num(), NumBagEntries))
+	{
+		return false;
+	}
+
+	TArray<FParsedBagEntry, TInlineAllocator<64>> ParsedBagEntries;
+	ParsedBagEntries.SetNum(NumBagEntries);
+	for (FParsedBagEntry& ParsedEntry : ParsedBagEntries)
+	{
+		Reader << ParsedEntry.ItemNetIndex;
+		Reader.SerializeIntPacked(ParsedEntry.Quantity);
+	}
+
+	uint32 NumTrackedTools = 0;
+	if (Reader.IsError() || !ReadCount(Reader, static_cast<int32>(NumToolHandles), NumTrackedTools))
+	{
+		return false;
+	}
+
+	TArray<FParsedTrackedTool, TInlineAllocator<32>> ParsedTrackedTools;
+	ParsedTrackedTools.SetNum(NumTrackedTools);
+	for (FParsedTrackedTool& ParsedTrackedTool : ParsedTrackedTools)
+	{
+		Reader.SerializeIntPacked(ParsedTrackedTool.OwnerPlayerIdPlusOne);
+		Reader << ParsedTrackedTool.WorldLocation;
+		Reader << ParsedTrackedTool.bIsDropped;
+	}
+
+	if (Reader.IsError())
+	{
+		UE_LOG(LogCowFieldCleanup, Warning, TEXT("Rejected inventory snapshot for %s: truncated or corrupt payload."), *GetNameSafe(Inventory.GetOwner()));
+		return false;
+	}
+
+	LLM_SCOPE_BYTAG(Inventory);
+
+	Inventory.InitializeToolSlots();
+	const int32 NumRestoredSlots = FMath::Min(ParsedSlots.Num(), Inventory.ToolSlots.Num());
+	for (int32 SlotIndex = 0; SlotIndex < NumRestoredSlots; ++SlotIndex)
+	{
+		const FParsedSlot& ParsedSlot = ParsedSlots[SlotIndex];
+		if (ParsedSlot.ToolHandle == EmptySlotHandle)
+		{
+			continue;
+		}
+
+		if (UItemDefinitionDataAsset* ItemDefinition = UItemDefinitionRegistry::ResolveNetIndex(ParsedSlot.ItemNetIndex))
+		{
+			Inventory.ApplyToolSlot(SlotIndex, ItemDefinition, ToolHandles[ParsedSlot.ToolHandle - 1]);
+		}
+	}
+
+	while (!Inventory.BagEntries.Items.IsEmpty())
+	{
+		const FBagItemEntry& LastEntry = Inventory.BagEntries.Items.Last();
+		if (!Inventory.ApplyRemoveBagItem(LastEntry.ItemDefinition, LastEntry.Quantity))
+		{
+			break;
+		}
+	}
+
+	for (const FParsedBagEntry& ParsedEntry : ParsedBagEntries)
+	{
+		UItemDefinitionDataAsset* ItemDefinition = UItemDefinitionRegistry::ResolveNetIndex(ParsedEntry.ItemNetIndex);
+		if (ItemDefinition && ParsedEntry.Quantity > 0)
+		{
+			Inventory.ApplyAddBagItem(ItemDefinition, static_cast<int32>(FMath::Min<uint32>(ParsedEntry.Quantity, MAX_int32)));
+		}
+	}
+	Inventory.RecalculateBagWeight();
+
+	// Dropped tool actors stay behind on the old map, so only carried tools come back. They belong to whoever
+	// owns this inventory now and sit with its owner, not at the old map's coordinates.
+	UDroppedToolRegistrySubsystem* ToolRegistry = Inventory.GetToolRegistry();
+	const AActor* Owner = Inventory.GetOwner();
+	for (int32 TrackedIndex = 0; TrackedIndex < ParsedTrackedTools.Num(); ++TrackedIndex)
+	{
+		if (ParsedTrackedTools[TrackedIndex].bIsDropped != 0)
+		{
+			continue;
+		}
+
+		FTrackedTool TrackedTool;
+		TrackedTool.ToolId = ToolHandles[TrackedIndex];
+		TrackedTool.OwnerPlayerId = Inventory.GetOwnerPlayerId();
+		TrackedTool.WorldLocation = Owner ? Owner->GetActorLocation() : FVector::ZeroVector;
+		TrackedTool.bIsDropped = false;
+
+		if (UInventoryComponent* PreviousComponent = ToolRegistry ? ToolRegistry->RegisterTool(TrackedTool, &Inventory) : nullptr)
+		{
+			PreviousComponent->RemoveTrackedToolMirror(TrackedTool.ToolId);
+		}
+		Inventory.UpsertTrackedToolMirror(TrackedTool);
+	}
+
+	Inventory.MarkInventoryChanged(EInventoryChangeFlags::ToolSlots | EInventoryChangeFlags::BagEntries | EInventoryChangeFlags::TrackedTools);
+	return true;
+}
@@ -0,0 +1,26 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+class UInventoryComponent;
+
+// Versioned binary image of an inventory's tool slots, bag entries and tracked tools, used to carry
+// state across level transitions. Item definitions are written as UItemDefinitionRegistry net indices
+// and tool GUIDs through a per-snapshot handle table, so a snapshot is only valid inside the build that
+// wrote it and is not meant for save games on disk.
+struct COWFIELDCLEANUP_API FInventorySnapshot
+{
+	enum class EVersion : uint8
+	{
+		Initial = 1,
+
+		LatestPlusOne,
+		Latest = LatestPlusOne - 1
+	};
+
+	static void Save(const UInventoryComponent& Inventory, TArray<uint8>& OutBytes);
+
+	// Replaces the slots and bag and re-registers the carried tracked tools on the authority under the inventory's
+	// current owner. Dropped tools are not restored. A malformed snapshot leaves the inventory untouched.
+	static bool Load(UInventoryComponent& Inventory, TConstArrayView<uint8> Bytes);
+};
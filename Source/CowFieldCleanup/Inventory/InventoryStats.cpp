@@ -0,0 +1,191 @@
+#include "Inventory/InventoryStats.h"
+
+#include "Containers/Ticker.h"
+#include "CowFieldCleanup.h"
+#include "Engine/NetSerialization.h"
+#include "HAL/IConsoleManager.h"
+#include "Inventory/InventoryComponent.h"
+#include "UObject/UObjectIterator.h"
+
+LLM_DEFINE_TAG(Inventory);
+
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Reliable RPCs Sent/sec"), STAT_InventoryReliableRpcsSentPerSecond, STATGROUP_Inventory);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Reliable RPCs Received/sec"), STAT_InventoryReliableRpcsReceivedPerSecond, STATGROUP_Inventory);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Rejected RPCs/sec"), STAT_InventoryRejectedRpcsPerSecond, STATGROUP_Inventory);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Replicated Bytes/sec"), STAT_InventoryReplicatedBytesPerSecond, STATGROUP_Inventory);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Replicated Bytes/sec per Component"), STAT_InventoryReplicatedBytesPerComponent, STATGROUP_Inventory);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Inventory Components"), STAT_InventoryComponents, STATGROUP_Inventory);
+
+TRACE_DECLARE_INT_COUNTER(InventoryReliableRpcsSent, TEXT("Inventory/ReliableRpcsSentPerSecond"));
+TRACE_DECLARE_INT_COUNTER(InventoryReliableRpcsReceived, TEXT("Inventory/ReliableRpcsReceivedPerSecond"));
+TRACE_DECLARE_INT_COUNTER(InventoryRejectedRpcs, TEXT("Inventory/RejectedRpcsPerSecond"));
+TRACE_DECLARE_INT_COUNTER(InventoryReplicatedBytes, TEXT("Inventory/ReplicatedBytesPerSecond"));
+TRACE_DECLARE_INT_COUNTER(InventoryReplicatedBytesPerComponent, TEXT("Inventory/ReplicatedBytesPerSecondPerComponent"));
+
+static TAutoConsoleVariable<bool> CVarInventoryMeasureReplicatedBytes(
+	TEXT("Inventory.MeasureReplicatedBytes"),
+	false,
+	TEXT("Net serializes changed inventory entries to count replicated bytes even when no stat or trace is collecting. Otherwise entries count as their struct size."));
+
+namespace InventoryStats
+{
+	static std::atomic<uint32> ReliableRpcsSent{ 0 };
+	static std::atomic<uint32> ReliableRpcsReceived{ 0 };
+	static std::atomic<uint32> RejectedRpcs{ 0 };
+	static std::atomic<uint32> ReplicatedBytes{ 0 };
+	static std::atomic<int32> NumComponents{ 0 };
+	static std::atomic<uint64> TotalReliableRpcsSent{ 0 };
+	static std::atomic<uint64> TotalReliableRpcsReceived{ 0 };
+	static std::atomic<uint64> TotalRpcsRejected{ 0 };
+	static std::atomic<uint64> TotalReplicatedBytes{ 0 };
+	static FTSTicker::FDelegateHandle PublishTickerHandle;
+
+	static bool PublishCounters(float DeltaTime)
+	{
+		const float Seconds = FMath::Max(DeltaTime, UE_SMALL_NUMBER);
+		const uint32 SentPerSecond = FMath::RoundToInt(ReliableRpcsSent.exchange(0) / Seconds);
+		const uint32 ReceivedPerSecond = FMath::RoundToInt(ReliableRpcsReceived.exchange(0) / Seconds);
+		const uint32 RejectedPerSecond = FMath::RoundToInt(RejectedRpcs.exchange(0) / Seconds);
+		const uint32 BytesPerSecond = FMath::RoundToInt(ReplicatedBytes.exchange(0) / Seconds);
+		const int32 Components = NumComponents.load();
+		const uint32 BytesPerComponent = Components > 0 ? BytesPerSecond / Components : 0;
+
+		SET_DWORD_STAT(STAT_InventoryReliableRpcsSentPerSecond, SentPerSecond);
+		SET_DWORD_STAT(STAT_InventoryReliableRpcsReceivedPerSecond, ReceivedPerSecond);
+		SET_DWORD_STAT(STAT_InventoryRejectedRpcsPerSecond, RejectedPerSecond);
+		SET_DWORD_STAT(STAT_InventoryReplicatedBytesPerSecond, BytesPerSecond);
+		SET_DWORD_STAT(STAT_InventoryReplicatedBytesPerComponent, BytesPerComponent);
+		SET_DWORD_STAT(STAT_InventoryComponents, Components);
+
+		TRACE_COUNTER_SET(InventoryReliableRpcsSent, SentPerSecond);
+		TRACE_COUNTER_SET(InventoryReliableRpcsReceived, ReceivedPerSecond);
+		TRACE_COUNTER_SET(InventoryRejectedRpcs, RejectedPerSecond);
+		TRACE_COUNTER_SET(InventoryReplicatedBytes, BytesPerSecond);
+		TRACE_COUNTER_SET(InventoryReplicatedBytesPerComponent, BytesPerComponent);
+		return true;
+	}
+
+	static void DumpReplicatedBytes(const TArray<FString>& Args)
+	{
+		if (!IsMeasuringReplicatedBytes())
+		{
+			SetMeasureReplicatedBytes(true);
+			UE_LOG(LogCowFieldCleanup, Display, TEXT("Inventory.MeasureReplicatedBytes is now on; counts below are struct sizes until this point."));
+		}
+
+		uint64 TotalBytes = 0;
+		for (TObjectIterator<UInventoryComponent> It; It; ++It)
+		{
+			const UInventoryComponent* Component = *It;
+			if (Component->IsTemplate() || !Component->GetWorld())
+			{
+				continue;
+			}
+
+			TotalBytes += Component->GetEstimatedReplicatedBytes();
+			UE_LOG(LogCowFieldCleanup, Display, TEXT("%s: %llu replicated bytes"), *GetPathNameSafe(Component), Component->GetEstimatedReplicatedBytes());
+		}
+
+		UE_LOG(LogCowFieldCleanup, Display, TEXT("Total: %llu replicated bytes"), TotalBytes);
+	}
+
+	static FAutoConsoleCommand DumpReplicatedBytesCommand(
+		TEXT("Inventory.DumpReplicatedBytes"),
+		TEXT("Logs the estimated replicated property bytes of every live inventory component."),
+		FConsoleCommandWithArgsDelegate::CreateStatic(&DumpReplicatedBytes));
+
+	void RecordReliableRpcSent()
+	{
+		ReliableRpcsSent.fetch_add(1, std::memory_order_relaxed);
+		TotalReliableRpcsSent.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	void RecordReliableRpcReceived()
+	{
+		ReliableRpcsReceived.fetch_add(1, std::memory_order_relaxed);
+		TotalReliableRpcsReceived.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	void RecordRpcRejected()
+	{
+		RejectedRpcs.fetch_add(1, std::memory_order_relaxed);
+		TotalRpcsRejected.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	void RecordReplicatedBytes(uint32 NumBytes)
+	{
+		ReplicatedBytes.fetch_add(NumBytes, std::memory_order_relaxed);
+		TotalReplicatedBytes.fetch_add(NumBytes, std::memory_order_relaxed);
+	}
+
+	FTotals GetTotals()
+	{
+		FTotals Totals;
+		Totals.ReliableRpcsSent = TotalReliableRpcsSent.load(std::memory_order_relaxed);
+		Totals.ReliableRpcsReceived = TotalReliableRpcsReceived.load(std::memory_order_relaxed);
+		Totals.RpcsRejected = TotalRpcsRejected.load(std::memory_order_relaxed);
+		Totals.ReplicatedBytes = TotalReplicatedBytes.load(std::memory_order_relaxed);
+		return Totals;
+	}
+
+	void RegisterComponent()
+	{
+		NumComponents.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	void UnregisterComponent()
+	{
+		NumComponents.fetch_sub(1, std::memory_order_relaxed);
+	}
+
+	void StartPublishing()
+	{
+#if INVENTORY_STATS_ENABLED
+		if (!PublishTickerHandle.IsValid())
+		{
+			PublishTickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateStatic(&PublishCounters), 1.0f);
+		}
+#endif
+	}
+
+	void StopPublishing()
+	{
+		if (PublishTickerHandle.IsValid())
+		{
+			FTSTicker::GetCoreTicker().RemoveTicker(PublishTickerHandle);
+			PublishTickerHandle.Reset();
+		}
+	}
+
+	bool IsMeasuringReplicatedBytes()
+	{
+#if STATS
+		if (FThreadStats::IsCollectingData())
+		{
+			return true;
+		}
+#endif
+#if COUNTERSTRACE_ENABLED
+		if (UE_TRACE_CHANNELEXPR_IS_ENABLED(CounterChannel))
+		{
+			return true;
+		}
+#endif
+		return CVarInventoryMeasureReplicatedBytes.GetValueOnGameThread();
+	}
+
+	void SetMeasureReplicatedBytes(bool bEnabled)
+	{
+		CVarInventoryMeasureReplicatedBytes->Set(bEnabled, ECVF_SetByCode);
+	}
+
+	uint32 MeasureNetSerializedBytes(TFunctionRef<void(FArchive&)> Serialize)
+	{
+		check(IsInGameThread());
+
+		static FNetBitWriter Writer(nullptr, 1024 * 8);
+		Writer.Reset();
+		Serialize(Writer);
+		return static_cast<uint32>(Writer.GetNumBytes());
+	}
+}
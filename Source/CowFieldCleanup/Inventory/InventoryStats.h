@@ -0,0 +1,82 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/LowLevelMemTracker.h"
+#include "ProfilingDebugging/CountersTrace.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+#include "Stats/Stats.h"
+#include "UObject/Class.h"
+
+#define INVENTORY_STATS_ENABLED (STATS || COUNTERSTRACE_ENABLED)
+
+DECLARE_STATS_GROUP(TEXT("Inventory"), STATGROUP_Inventory, STATCAT_Advanced);
+
+LLM_DECLARE_TAG_API(Inventory, COWFIELDCLEANUP_API);
+
+// Times the enclosing scope under STATGROUP_Inventory and as an Insights CPU event, and attributes
+// its allocations to the Inventory LLM tag. The stat must be declared with DECLARE_CYCLE_STAT.
+#define INVENTORY_SCOPE_CYCLE_COUNTER(Stat) \
+	SCOPE_CYCLE_COUNTER(Stat); \
+	TRACE_CPUPROFILER_EVENT_SCOPE(Stat); \
+	LLM_SCOPE_BYTAG(Inventory)
+
+namespace InventoryStats
+{
+	COWFIELDCLEANUP_API void RecordReliableRpcSent();
+	COWFIELDCLEANUP_API void RecordReliableRpcReceived();
+	COWFIELDCLEANUP_API void RecordReplicatedBytes(uint32 NumBytes);
+	COWFIELDCLEANUP_API void RecordRpcRejected();
+
+	struct FTotals
+	{
+		uint64 ReliableRpcsSent = 0;
+		uint64 ReliableRpcsReceived = 0;
+		uint64 RpcsRejected = 0;
+		uint64 ReplicatedBytes = 0;
+	};
+
+	// Running counts since startup, for measuring windows longer than one publish period.
+	COWFIELDCLEANUP_API FTotals GetTotals();
+
+	COWFIELDCLEANUP_API void RegisterComponent();
+	COWFIELDCLEANUP_API void UnregisterComponent();
+
+	// Publishes the per-second counters; driven by the module's core ticker.
+	void StartPublishing();
+	void StopPublishing();
+
+	// True while the Inventory stat group or the counters trace channel is collecting, or Inventory.MeasureReplicatedBytes is set.
+	COWFIELDCLEANUP_API bool IsMeasuringReplicatedBytes();
+	COWFIELDCLEANUP_API void SetMeasureReplicatedBytes(bool bEnabled);
+
+	// Game thread only; reuses a single writer so measuring does not allocate.
+	COWFIELDCLEANUP_API uint32 MeasureNetSerializedBytes(TFunctionRef<void(FArchive&)> Serialize);
+
+	// Falls back to the struct size unless something is reading the numbers, so mutations skip the copy and serialize.
+	template<typename StructType>
+	uint32 EstimateReplicatedBytes(const StructType& Value)
+	{
+#if INVENTORY_STATS_ENABLED
+		if constexpr (TStructOpsTypeTraits<StructType>::WithNetSerializer)
+		{
+			if (!IsMeasuringReplicatedBytes())
+			{
+				return sizeof(StructType);
+			}
+
+			StructType Copy = Value;
+			return MeasureNetSerializedBytes([&Copy](FArchive& Ar)
+			{
+				bool bSuccess = false;
+				Copy.NetSerialize(Ar, nullptr, bSuccess);
+			});
+		}
+		else
+		{
+			return sizeof(StructType);
+		}
+#else
+		return 0;
+#endif
+	}
+}
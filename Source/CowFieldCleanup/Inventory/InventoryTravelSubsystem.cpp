@@ -0,0 +1,91 @@
+#include "Inventory/InventoryTravelSubsystem.h"
+
+#include "CowFieldCleanup.h"
+#include "Engine/GameInstance.h"
+#include "Engine/World.h"
+#include "Inventory/InventoryComponent.h"
+#include "Inventory/InventorySnapshot.h"
+#include "Inventory/InventoryStats.h"
+#include "UObject/UObjectIterator.h"
+
+void UInventoryTravelSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	SeamlessTravelStartHandle = FWorldDelegates::OnSeamlessTravelStart.AddUObject(this, &UInventoryTravelSubsystem::HandleSeamlessTravelStart);
+}
+
+void UInventoryTravelSubsystem::Deinitialize()
+{
+	FWorldDelegates::OnSeamlessTravelStart.Remove(SeamlessTravelStartHandle);
+	SeamlessTravelStartHandle.Reset();
+	SnapshotsByPlayer.Reset();
+
+	Super::Deinitialize();
+}
+
+void UInventoryTravelSubsystem::CaptureAllInventories()
+{
+	CaptureInventoriesInWorld(GetGameInstance()->GetWorld());
+}
+
+void UInventoryTravelSubsystem::DiscardSnapshots()
+{
+	SnapshotsByPlayer.Reset();
+}
+
+int32 UInventoryTravelSubsystem::GetNumPendingSnapshots() const
+{
+	return SnapshotsByPlayer.Num();
+}
+
+bool UInventoryTravelSubsystem::CaptureInventory(const UInventoryComponent& Inventory)
+{
+	const FUniqueNetIdRepl PlayerId = Inventory.GetOwnerUniqueNetId();
+	if (!PlayerId.IsValid() || !Inventory.CanModifyInventory())
+	{
+		return false;
+	}
+
+	LLM_SCOPE_BYTAG(Inventory);
+	FInventorySnapshot::Save(Inventory, SnapshotsByPlayer.FindOrAdd(PlayerId));
+	return true;
+}
+
+bool UInventoryTravelSubsystem::RestoreInventory(UInventoryComponent& Inventory)
+{
+	const FUniqueNetIdRepl PlayerId = Inventory.GetOwnerUniqueNetId();
+	TArray<uint8> Snapshot;
+	if (!PlayerId.IsValid() || !SnapshotsByPlayer.RemoveAndCopyValue(PlayerId, Snapshot))
+	{
+		return false;
+	}
+
+	const bool bLoaded = FInventorySnapshot::Load(Inventory, Snapshot);
+	UE_CLOG(!bLoaded, LogCowFieldCleanup, Warning, TEXT("Discarded travel snapshot for %s."), *PlayerId.ToString());
+	return bLoaded;
+}
+
+void UInventoryTravelSubsystem::CaptureInventoriesInWorld(const UWorld* World)
+{
+	if (!World)
+	{
+		return;
+	}
+
+	for (TObjectIterator<UInventoryComponent> It; It; ++It)
+	{
+		if (It->GetWorld() == World && It->HasBegunPlay())
+		{
+			CaptureInventory(**It);
+		}
+	}
+}
+
+void UInventoryTravelSubsystem::HandleSeamlessTravelStart(UWorld* World, const FString& LevelName)
+{
+	if (World && World->GetGameInstance() == GetGameInstance())
+	{
+		CaptureInventoriesInWorld(World);
+	}
+}
@@ -0,0 +1,43 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/OnlineReplStructs.h"
+#include "Subsystems/GameInstanceSubsystem.h"
+#include "InventoryTravelSubsystem.generated.h"
+
+class UInventoryComponent;
+
+// Holds inventory snapshots across field/camp transitions, keyed by the player's unique net id. Inventories
+// are captured when seamless travel starts or their owner ends play on a level transition, and restored by
+// UInventoryComponent on the authority once its owner has a player state.
+UCLASS()
+class COWFIELDCLEANUP_API UInventoryTravelSubsystem : public UGameInstanceSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+
+	// Snapshots every authoritative inventory in the current world, e.g. before a non-seamless camp transition.
+	UFUNCTION(BlueprintCallable, Category = "Inventory|Travel")
+	void CaptureAllInventories();
+
+	UFUNCTION(BlueprintCallable, Category = "Inventory|Travel")
+	void DiscardSnapshots();
+
+	UFUNCTION(BlueprintPure, Category = "Inventory|Travel")
+	int32 GetNumPendingSnapshots() const;
+
+	bool CaptureInventory(const UInventoryComponent& Inventory);
+
+	// Applies and consumes the snapshot stored for the inventory's player, if any.
+	bool RestoreInventory(UInventoryComponent& Inventory);
+
+private:
+	void CaptureInventoriesInWorld(const UWorld* World);
+	void HandleSeamlessTravelStart(UWorld* World, const FString& LevelName);
+
+	TMap<FUniqueNetIdRepl, TArray<uint8>> SnapshotsByPlayer;
+	FDelegateHandle SeamlessTravelStartHandle;
+};
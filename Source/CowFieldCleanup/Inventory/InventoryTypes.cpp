@@ -0,0 +1,229 @@
+#include "Inventory/InventoryTypes.h"
+
+#include "DataAssets/ItemDefinitionDataAsset.h"
+#include "Inventory/InventoryComponent.h"
+#include "Inventory/ItemDefinitionRegistry.h"
+
+namespace InventoryNetSerialization
+{
+	static void SerializeItemDefinition(FArchive& Ar, TObjectPtr<UItemDefinitionDataAsset>& ItemDefinition)
+	{
+		uint16 NetIndex = Ar.IsSaving() ? UItemDefinitionRegistry::GetNetIndex(ItemDefinition) : UItemDefinitionRegistry::InvalidNetIndex;
+		Ar << NetIndex;
+
+		if (Ar.IsLoading())
+		{
+			ItemDefinition = UItemDefinitionRegistry::ResolveNetIndex(NetIndex);
+		}
+	}
+}
+
+bool FToolSlotEntry::NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess)
+{
+	uint8 bOccupiedBit = bOccupied ? 1 : 0;
+	Ar.SerializeBits(&bOccupiedBit, 1);
+	bOccupied = bOccupiedBit != 0;
+
+	if (bOccupied)
+	{
+		InventoryNetSerialization::SerializeItemDefinition(Ar, ItemDefinition);
+		Ar << ToolId;
+	}
+	else if (Ar.IsLoading())
+	{
+		ItemDefinition = nullptr;
+		ToolId.Invalidate();
+	}
+
+	bOutSuccess = !Ar.IsError();
+	return true;
+}
+
+bool FBagItemEntry::NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess)
+{
+	InventoryNetSerialization::SerializeItemDefinition(Ar, ItemDefinition);
+
+	uint32 PackedQuantity = static_cast<uint32>(FMath::Max(0, Quantity));
+	Ar.SerializeIntPacked(PackedQuantity);
+	Quantity = static_cast<int32>(FMath::Min<uint32>(PackedQuantity, MAX_int32));
+
+	bOutSuccess = !Ar.IsError();
+	return true;
+}
+
+bool FInventoryBatchOp::NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess)
+{
+	uint8 RawType = static_cast<uint8>(Type);
+	Ar.SerializeBits(&RawType, 2);
+	Type = static_cast<EInventoryBatchOpType>(RawType);
+
+	if (Type != EInventoryBatchOpType::RemoveToolFromSlot)
+	{
+		InventoryNetSerialization::SerializeItemDefinition(Ar, ItemDefinition);
+	}
+
+	if (Type == EInventoryBatchOpType::AddToolToSlot)
+	{
+		Ar << ToolId;
+	}
+
+	uint32 PackedArgument = static_cast<uint32>(FMath::Max(0, Argument));
+	Ar.SerializeIntPacked(PackedArgument);
+	Argument = static_cast<int32>(FMath::Min<uint32>(PackedArgument, MAX_int32));
+
+	bOutSuccess = !Ar.IsError();
+	return true;
+}
+
+bool FToolLocatorResult::NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess)
+{
+	Ar << ToolId;
+
+	uint8 RawBand = static_cast<uint8>(DistanceBand);
+	Ar.SerializeBits(&RawBand, 2);
+	DistanceBand = static_cast<ELocatorDistanceBand>(RawBand);
+
+	uint8 PackedYaw = Ar.IsSaving() ? FRotator::CompressAxisToByte(DirectionYaw) : 0;
+	Ar << PackedYaw;
+
+	uint32 PackedMeters = Ar.IsSaving() ? static_cast<uint32>(FMath::RoundToInt32(FMath::Max(0.0f, Distance) / 100.0f)) : 0;
+	Ar.SerializeIntPacked(PackedMeters);
+
+	if (Ar.IsLoading())
+	{
+		DirectionYaw = FRotator::DecompressAxisFromByte(PackedYaw);
+		Distance = PackedMeters * 100.0f;
+	}
+
+	bOutSuccess = !Ar.IsError();
+	return true;
+}
+
+bool FTeamCleanupProgress::NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess)
+{
+	constexpr uint32 MaxSerializedEntries = 1024;
+
+	Ar << TotalBagWeight;
+
+	uint32 PackedTarget = static_cast<uint32>(FMath::Max(0, TargetCleanupQuantity));
+	Ar.SerializeIntPacked(PackedTarget);
+	TargetCleanupQuantity = static_cast<int32>(FMath::Min<uint32>(PackedTarget, MAX_int32));
+
+	for (int32& CategoryQuantity : QuantityByCategory)
+	{
+		uint32 PackedQuantity = static_cast<uint32>(FMath::Max(0, CategoryQuantity));
+		Ar.SerializeIntPacked(PackedQuantity);
+		CategoryQuantity = static_cast<int32>(FMath::Min<uint32>(PackedQuantity, MAX_int32));
+	}
+
+	uint32 NumItemTotals = ItemTotals.Num();
+	Ar.SerializeIntPacked(NumItemTotals);
+	if (NumItemTotals > MaxSerializedEntries)
+	{
+		Ar.SetError();
+		bOutSuccess = false;
+		return true;
+	}
+
+	if (Ar.IsLoading())
+	{
+		ItemTotals.SetNum(NumItemTotals, EAllowShrinking::No);
+	}
+
+	for (FTeamItemTotal& ItemTotal : ItemTotals)
+	{
+		InventoryNetSerialization::SerializeItemDefinition(Ar, ItemTotal.ItemDefinition);
+
+		uint32 PackedQuantity = static_cast<uint32>(FMath::Max(0, ItemTotal.Quantity));
+		Ar.SerializeIntPacked(PackedQuantity);
+		ItemTotal.Quantity = static_cast<int32>(FMath::Min<uint32>(PackedQuantity, MAX_int32));
+	}
+
+	uint32 NumPlayerLoads = PlayerLoads.Num();
+	Ar.SerializeIntPacked(NumPlayerLoads);
+	if (NumPlayerLoads > MaxSerializedEntries)
+	{
+		Ar.SetError();
+		bOutSuccess = false;
+		return true;
+	}
+
+	if (Ar.IsLoading())
+	{
+		PlayerLoads.SetNum(NumPlayerLoads, EAllowShrinking::No);
+	}
+
+	for (FPlayerCleanupLoad& PlayerLoad : PlayerLoads)
+	{
+		// Shifted by one so an unassigned player (INDEX_NONE) still packs small.
+		uint32 PackedPlayerId = static_cast<uint32>(FMath::Max(INDEX_NONE, PlayerLoad.PlayerId) + 1);
+		Ar.SerializeIntPacked(PackedPlayerId);
+		PlayerLoad.PlayerId = static_cast<int32>(PackedPlayerId) - 1;
+
+		uint32 PackedItemCount = static_cast<uint32>(FMath::Max(0, PlayerLoad.ItemCount));
+		Ar.SerializeIntPacked(PackedItemCount);
+		PlayerLoad.ItemCount = static_cast<int32>(FMath::Min<uint32>(PackedItemCount, MAX_int32));
+
+		Ar << PlayerLoad.BagWeight;
+	}
+
+	bOutSuccess = !Ar.IsError();
+	return true;
+}
+
+bool FTeamCleanupProgress::operator==(const FTeamCleanupProgress& Other) const
+{
+	return TotalBagWeight == Other.TotalBagWeight
+		&& TargetCleanupQuantity == Other.TargetCleanupQuantity
+		&& FMemory::Memcmp(QuantityByCategory, Other.QuantityByCategory, sizeof(QuantityByCategory)) == 0
+		&& ItemTotals == Other.ItemTotals
+		&& PlayerLoads == Other.PlayerLoads;
+}
+
+void FBagItemEntry::PreReplicatedRemove(const FBagItemArray& InArraySerializer)
+{
+	if (InArraySerializer.OwnerComponent)
+	{
+		InArraySerializer.OwnerComponent->HandleBagEntryReplicated(*this, EInventoryEntryChange::Removed);
+	}
+}
+
+void FBagItemEntry::PostReplicatedAdd(const FBagItemArray& InArraySerializer)
+{
+	if (InArraySerializer.OwnerComponent)
+	{
+		InArraySerializer.OwnerComponent->HandleBagEntryReplicated(*this, EInventoryEntryChange::Added);
+	}
+}
+
+void FBagItemEntry::PostReplicatedChange(const FBagItemArray& InArraySerializer)
+{
+	if (InArraySerializer.OwnerComponent)
+	{
+		InArraySerializer.OwnerComponent->HandleBagEntryReplicated(*this, EInventoryEntryChange::Changed);
+	}
+}
+
+void FTrackedTool::PreReplicatedRemove(const FTrackedToolArray& InArraySerializer)
+{
+	if (InArraySerializer.OwnerComponent)
+	{
+		InArraySerializer.OwnerComponent->HandleTrackedToolReplicated(*this, EInventoryEntryChange::Removed);
+	}
+}
+
+void FTrackedTool::PostReplicatedAdd(const FTrackedToolArray& InArraySerializer)
+{
+	if (InArraySerializer.OwnerComponent)
+	{
+		InArraySerializer.OwnerComponent->HandleTrackedToolReplicated(*this, EInventoryEntryChange::Added);
+	}
+}
+
+void FTrackedTool::PostReplicatedChange(const FTrackedToolArray& InArraySerializer)
+{
+	if (InArraySerializer.OwnerComponent)
+	{
+		InArraySerializer.OwnerComponent->HandleTrackedToolReplicated(*this, EInventoryEntryChange::Changed);
+	}
+}
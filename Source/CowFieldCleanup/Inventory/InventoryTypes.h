@@ -1,15 +1,19 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "Net/Serialization/FastArraySerializer.h"
 #include "InventoryTypes.generated.h"
 
+class UInventoryComponent;
 class UItemDefinitionDataAsset;
 
 UENUM(BlueprintType)
 enum class EInventoryItemCategory : uint8
 {
 	Tool,
-	Cleanup
+	Cleanup,
+
+	Num UMETA(Hidden)
 };
 
 UENUM(BlueprintType)
@@ -21,6 +25,14 @@ enum class ELocatorDistanceBand : uint8
 	Unknown
 };
 
+UENUM(BlueprintType)
+enum class EInventoryEntryChange : uint8
+{
+	Added,
+	Changed,
+	Removed
+};
+
 USTRUCT(BlueprintType)
 struct FToolSlotEntry
 {
@@ -34,10 +46,108 @@ struct FToolSlotEntry
 
 	UPROPERTY(EditAnywhere, BlueprintReadOnly)
 	bool bOccupied = false;
+
+	bool NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess);
+};
+
+template<>
+struct TStructOpsTypeTraits<FToolSlotEntry> : public TStructOpsTypeTraitsBase2<FToolSlotEntry>
+{
+	enum
+	{
+		WithNetSerializer = true
+	};
+};
+
+UENUM(BlueprintType, meta = (Bitflags, UseEnumValuesAsMaskValuesInEditor = "true"))
+enum class EInventoryChangeFlags : uint8
+{
+	None = 0 UMETA(Hidden),
+	ToolSlots = 1 << 0,
+	BagEntries = 1 << 1,
+	BagWeight = 1 << 2,
+	TrackedTools = 1 << 3
+};
+ENUM_CLASS_FLAGS(EInventoryChangeFlags);
+
+// Server RPCs are rate limited per connection in these groups.
+UENUM()
+enum class EInventoryRpcFamily : uint8
+{
+	Inventory,
+	DroppedTool,
+	// Unreliable location streaming, kept apart so a burst cannot starve the reliable settle update.
+	DroppedToolStream,
+	Locator,
+
+	Num UMETA(Hidden)
+};
+
+USTRUCT(BlueprintType)
+struct FInventoryRpcRateLimit
+{
+	GENERATED_BODY()
+
+	FInventoryRpcRateLimit() = default;
+
+	FInventoryRpcRateLimit(float InTokensPerSecond, float InBurst)
+		: TokensPerSecond(InTokensPerSecond)
+		, Burst(InBurst)
+	{
+	}
+
+	// Sustained calls per second; zero disables the limit.
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, meta = (ClampMin = "0.0"))
+	float TokensPerSecond = 0.0f;
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, meta = (ClampMin = "1.0"))
+	float Burst = 1.0f;
+};
+
+UENUM()
+enum class EInventoryBatchOpType : uint8
+{
+	AddToolToSlot,
+	RemoveToolFromSlot,
+	AddBagItem,
+	RemoveBagItem
+};
+
+USTRUCT()
+struct FInventoryBatchOp
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	EInventoryBatchOpType Type = EInventoryBatchOpType::AddBagItem;
+
+	UPROPERTY()
+	TObjectPtr<UItemDefinitionDataAsset> ItemDefinition;
+
+	UPROPERTY()
+	FGuid ToolId;
+
+	// Slot index for slot operations, quantity for bag operations.
+	UPROPERTY()
+	int32 Argument = 0;
+
+	bool NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess);
 };
 
+template<>
+struct TStructOpsTypeTraits<FInventoryBatchOp> : public TStructOpsTypeTraitsBase2<FInventoryBatchOp>
+{
+	enum
+	{
+		WithNetSerializer = true
+	};
+};
+
+struct FBagItemArray;
+struct FTrackedToolArray;
+
 USTRUCT(BlueprintType)
-struct FBagItemEntry
+struct FBagItemEntry : public FFastArraySerializerItem
 {
 	GENERATED_BODY()
 
@@ -46,10 +156,51 @@ struct FBagItemEntry
 
 	UPROPERTY(EditAnywhere, BlueprintReadOnly)
 	int32 Quantity = 0;
+
+	bool NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess);
+
+	void PreReplicatedRemove(const FBagItemArray& InArraySerializer);
+	void PostReplicatedAdd(const FBagItemArray& InArraySerializer);
+	void PostReplicatedChange(const FBagItemArray& InArraySerializer);
+};
+
+template<>
+struct TStructOpsTypeTraits<FBagItemEntry> : public TStructOpsTypeTraitsBase2<FBagItemEntry>
+{
+	enum
+	{
+		WithNetSerializer = true
+	};
+};
+
+USTRUCT()
+struct FBagItemArray : public FFastArraySerializer
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	TArray<FBagItemEntry> Items;
+
+	UPROPERTY(NotReplicated)
+	TObjectPtr<UInventoryComponent> OwnerComponent;
+
+	bool NetDeltaSerialize(FNetDeltaSerializeInfo& DeltaParms)
+	{
+		return FFastArraySerializer::FastArrayDeltaSerialize<FBagItemEntry, FBagItemArray>(Items, DeltaParms, *this);
+	}
+};
+
+template<>
+struct TStructOpsTypeTraits<FBagItemArray> : public TStructOpsTypeTraitsBase2<FBagItemArray>
+{
+	enum
+	{
+		WithNetDeltaSerializer = true
+	};
 };
 
 USTRUCT(BlueprintType)
-struct FTrackedTool
+struct FTrackedTool : public FFastArraySerializerItem
 {
 	GENERATED_BODY()
 
@@ -64,4 +215,139 @@ struct FTrackedTool
 
 	UPROPERTY(EditAnywhere, BlueprintReadOnly)
 	bool bIsDropped = false;
+
+	void PreReplicatedRemove(const FTrackedToolArray& InArraySerializer);
+	void PostReplicatedAdd(const FTrackedToolArray& InArraySerializer);
+	void PostReplicatedChange(const FTrackedToolArray& InArraySerializer);
+};
+
+USTRUCT()
+struct FTrackedToolArray : public FFastArraySerializer
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	TArray<FTrackedTool> Items;
+
+	UPROPERTY(NotReplicated)
+	TObjectPtr<UInventoryComponent> OwnerComponent;
+
+	bool NetDeltaSerialize(FNetDeltaSerializeInfo& DeltaParms)
+	{
+		return FFastArraySerializer::FastArrayDeltaSerialize<FTrackedTool, FTrackedToolArray>(Items, DeltaParms, *this);
+	}
+};
+
+template<>
+struct TStructOpsTypeTraits<FTrackedToolArray> : public TStructOpsTypeTraitsBase2<FTrackedToolArray>
+{
+	enum
+	{
+		WithNetDeltaSerializer = true
+	};
+};
+
+USTRUCT(BlueprintType)
+struct FToolLocatorResult
+{
+	GENERATED_BODY()
+
+	UPROPERTY(BlueprintReadOnly)
+	FGuid ToolId;
+
+	UPROPERTY(BlueprintReadOnly)
+	ELocatorDistanceBand DistanceBand = ELocatorDistanceBand::Unknown;
+
+	// World yaw from the requesting player to the tool, quantized to a byte on the wire.
+	UPROPERTY(BlueprintReadOnly)
+	float DirectionYaw = 0.0f;
+
+	// Sent in whole meters.
+	UPROPERTY(BlueprintReadOnly)
+	float Distance = 0.0f;
+
+	bool NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess);
+};
+
+template<>
+struct TStructOpsTypeTraits<FToolLocatorResult> : public TStructOpsTypeTraitsBase2<FToolLocatorResult>
+{
+	enum
+	{
+		WithNetSerializer = true
+	};
+};
+
+USTRUCT(BlueprintType)
+struct FTeamItemTotal
+{
+	GENERATED_BODY()
+
+	UPROPERTY(BlueprintReadOnly)
+	TObjectPtr<UItemDefinitionDataAsset> ItemDefinition;
+
+	UPROPERTY(BlueprintReadOnly)
+	int32 Quantity = 0;
+
+	bool operator==(const FTeamItemTotal& Other) const
+	{
+		return ItemDefinition == Other.ItemDefinition && Quantity == Other.Quantity;
+	}
+};
+
+USTRUCT(BlueprintType)
+struct FPlayerCleanupLoad
+{
+	GENERATED_BODY()
+
+	UPROPERTY(BlueprintReadOnly)
+	int32 PlayerId = INDEX_NONE;
+
+	UPROPERTY(BlueprintReadOnly)
+	int32 ItemCount = 0;
+
+	UPROPERTY(BlueprintReadOnly)
+	float BagWeight = 0.0f;
+
+	bool operator==(const FPlayerCleanupLoad& Other) const
+	{
+		return PlayerId == Other.PlayerId && ItemCount == Other.ItemCount && BagWeight == Other.BagWeight;
+	}
+};
+
+// Team-wide bag totals, kept up to date from signed deltas pushed by each inventory's server
+// mutation paths so readers never have to walk every pawn's bag.
+USTRUCT(BlueprintType)
+struct FTeamCleanupProgress
+{
+	GENERATED_BODY()
+
+	UPROPERTY(BlueprintReadOnly)
+	float TotalBagWeight = 0.0f;
+
+	// Cleanup items the team has to be carrying at once to win; 0 means no target.
+	UPROPERTY(BlueprintReadOnly)
+	int32 TargetCleanupQuantity = 0;
+
+	int32 QuantityByCategory[static_cast<int32>(EInventoryItemCategory::Num)] = {};
+
+	UPROPERTY(BlueprintReadOnly)
+	TArray<FTeamItemTotal> ItemTotals;
+
+	// Sorted heaviest first.
+	UPROPERTY(BlueprintReadOnly)
+	TArray<FPlayerCleanupLoad> PlayerLoads;
+
+	bool NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess);
+	bool operator==(const FTeamCleanupProgress& Other) const;
+};
+
+template<>
+struct TStructOpsTypeTraits<FTeamCleanupProgress> : public TStructOpsTypeTraitsBase2<FTeamCleanupProgress>
+{
+	enum
+	{
+		WithNetSerializer = true,
+		WithIdenticalViaEquality = true
+	};
 };
@@ -0,0 +1,171 @@
+#include "Inventory/ItemDefinitionRegistry.h"
+
+#include "AssetRegistry/IAssetRegistry.h"
+#include "CowFieldCleanup.h"
+#include "DataAssets/ItemDefinitionDataAsset.h"
+#include "Engine/Engine.h"
+
+uint16 UItemDefinitionRegistry::GetNetIndex(const UItemDefinitionDataAsset* ItemDefinition)
+{
+	UItemDefinitionRegistry* Registry = ItemDefinition ? Get() : nullptr;
+	if (!Registry)
+	{
+		return InvalidNetIndex;
+	}
+
+	Registry->BuildIndexIfNeeded();
+	if (const uint16* NetIndex = Registry->NetIndexByItemId.Find(ItemDefinition->ItemId))
+	{
+		return *NetIndex;
+	}
+
+	bool bAlreadyWarned = false;
+	Registry->WarnedUnregisteredItemIds.Add(ItemDefinition->ItemId, &bAlreadyWarned);
+	UE_CLOG(!bAlreadyWarned, LogCowFieldCleanup, Warning, TEXT("Item definition %s (ItemId %s) is not registered and cannot be replicated."), *GetNameSafe(ItemDefinition), *ItemDefinition->ItemId.ToString());
+	return InvalidNetIndex;
+}
+
+UItemDefinitionDataAsset* UItemDefinitionRegistry::ResolveNetIndex(uint16 NetIndex)
+{
+	UItemDefinitionRegistry* Registry = NetIndex != InvalidNetIndex ? Get() : nullptr;
+	if (!Registry)
+	{
+		return nullptr;
+	}
+
+	Registry->BuildIndexIfNeeded();
+	if (!Registry->DefinitionPaths.IsValidIndex(NetIndex))
+	{
+		return nullptr;
+	}
+
+	TWeakObjectPtr<UItemDefinitionDataAsset>& Resolved = Registry->ResolvedDefinitions[NetIndex];
+	if (!Resolved.IsValid())
+	{
+		const FSoftObjectPath& DefinitionPath = Registry->DefinitionPaths[NetIndex];
+		UObject* DefinitionObject = DefinitionPath.ResolveObject();
+		if (!DefinitionObject)
+		{
+			UE_LOG(LogCowFieldCleanup, Warning, TEXT("Item definition %s was not preloaded; loading it synchronously."), *DefinitionPath.ToString());
+			DefinitionObject = DefinitionPath.TryLoad();
+		}
+		Resolved = Cast<UItemDefinitionDataAsset>(DefinitionObject);
+	}
+
+	return Resolved.Get();
+}
+
+uint16 UItemDefinitionRegistry::RegisterRuntimeDefinition(UItemDefinitionDataAsset* ItemDefinition)
+{
+	UItemDefinitionRegistry* Registry = ItemDefinition && !ItemDefinition->ItemId.IsNone() ? Get() : nullptr;
+	if (!Registry)
+	{
+		return InvalidNetIndex;
+	}
+
+	Registry->BuildIndexIfNeeded();
+	if (const uint16* ExistingNetIndex = Registry->NetIndexByItemId.Find(ItemDefinition->ItemId))
+	{
+		// The latest definition wins, whether or not the previous one has been garbage collected yet.
+		Registry->DefinitionPaths[*ExistingNetIndex] = FSoftObjectPath(ItemDefinition);
+		Registry->ResolvedDefinitions[*ExistingNetIndex] = ItemDefinition;
+		return *ExistingNetIndex;
+	}
+
+	if (Registry->DefinitionPaths.Num() >= InvalidNetIndex)
+	{
+		UE_LOG(LogCowFieldCleanup, Error, TEXT("Too many item definitions to index; %s will not be replicated."), *GetNameSafe(ItemDefinition));
+		return InvalidNetIndex;
+	}
+
+	const uint16 NetIndex = static_cast<uint16>(Registry->DefinitionPaths.Num());
+	Registry->NetIndexByItemId.Add(ItemDefinition->ItemId, NetIndex);
+	Registry->DefinitionPaths.Add(FSoftObjectPath(ItemDefinition));
+	Registry->ResolvedDefinitions.Add(ItemDefinition);
+	return NetIndex;
+}
+
+void UItemDefinitionRegistry::Deinitialize()
+{
+	DefinitionPaths.Reset();
+	ResolvedDefinitions.Reset();
+	NetIndexByItemId.Reset();
+	WarnedUnregisteredItemIds.Reset();
+	bIndexBuilt = false;
+
+	Super::Deinitialize();
+}
+
+void UItemDefinitionRegistry::RebuildIndex()
+{
+	DefinitionPaths.Reset();
+	ResolvedDefinitions.Reset();
+	NetIndexByItemId.Reset();
+	bIndexBuilt = true;
+
+	IAssetRegistry& AssetRegistry = IAssetRegistry::GetChecked();
+	if (AssetRegistry.IsLoadingAssets())
+	{
+		AssetRegistry.WaitForCompletion();
+	}
+
+	TArray<FAssetData> DefinitionAssets;
+	AssetRegistry.GetAssetsByClass(UItemDefinitionDataAsset::StaticClass()->GetClassPathName(), DefinitionAssets, true);
+
+	TArray<TPair<FName, FSoftObjectPath>> SortedDefinitions;
+	SortedDefinitions.Reserve(DefinitionAssets.Num());
+	for (const FAssetData& DefinitionAsset : DefinitionAssets)
+	{
+		const FName ItemId = DefinitionAsset.GetTagValueRef<FName>(GET_MEMBER_NAME_CHECKED(UItemDefinitionDataAsset, ItemId));
+		if (ItemId.IsNone())
+		{
+			UE_LOG(LogCowFieldCleanup, Warning, TEXT("Item definition %s has no ItemId and will not be replicated."), *DefinitionAsset.GetObjectPathString());
+			continue;
+		}
+
+		SortedDefinitions.Emplace(ItemId, DefinitionAsset.GetSoftObjectPath());
+	}
+
+	SortedDefinitions.Sort([](const TPair<FName, FSoftObjectPath>& A, const TPair<FName, FSoftObjectPath>& B)
+	{
+		return A.Key.LexicalLess(B.Key);
+	});
+
+	for (const TPair<FName, FSoftObjectPath>& Definition : SortedDefinitions)
+	{
+		if (NetIndexByItemId.Contains(Definition.Key))
+		{
+			UE_LOG(LogCowFieldCleanup, Error, TEXT("Duplicate ItemId %s on %s; only the first definition is replicated."), *Definition.Key.ToString(), *Definition.Value.ToString());
+			continue;
+		}
+
+		if (DefinitionPaths.Num() >= InvalidNetIndex)
+		{
+			UE_LOG(LogCowFieldCleanup, Error, TEXT("Too many item definitions to index; %s will not be replicated."), *Definition.Value.ToString());
+			break;
+		}
+
+		NetIndexByItemId.Add(Definition.Key, static_cast<uint16>(DefinitionPaths.Num()));
+		DefinitionPaths.Add(Definition.Value);
+	}
+
+	ResolvedDefinitions.SetNum(DefinitionPaths.Num());
+}
+
+int32 UItemDefinitionRegistry::GetNumDefinitions() const
+{
+	return DefinitionPaths.Num();
+}
+
+UItemDefinitionRegistry* UItemDefinitionRegistry::Get()
+{
+	return GEngine ? GEngine->GetEngineSubsystem<UItemDefinitionRegistry>() : nullptr;
+}
+
+void UItemDefinitionRegistry::BuildIndexIfNeeded()
+{
+	if (!bIndexBuilt)
+	{
+		RebuildIndex();
+	}
+}
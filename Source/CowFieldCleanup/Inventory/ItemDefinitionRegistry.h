@@ -0,0 +1,40 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/EngineSubsystem.h"
+#include "ItemDefinitionRegistry.generated.h"
+
+class UItemDefinitionDataAsset;
+
+UCLASS()
+class COWFIELDCLEANUP_API UItemDefinitionRegistry : public UEngineSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	static constexpr uint16 InvalidNetIndex = MAX_uint16;
+
+	static uint16 GetNetIndex(const UItemDefinitionDataAsset* ItemDefinition);
+	static UItemDefinitionDataAsset* ResolveNetIndex(uint16 NetIndex);
+
+	// Indexes a definition the asset registry does not know about (runtime or test-created). Every peer must
+	// register the same definitions in the same order. Registering an ItemId again keeps its index and rebinds it
+	// to the new definition; the entry is dropped on the next RebuildIndex.
+	static uint16 RegisterRuntimeDefinition(UItemDefinitionDataAsset* ItemDefinition);
+
+	virtual void Deinitialize() override;
+
+	void RebuildIndex();
+	int32 GetNumDefinitions() const;
+
+private:
+	static UItemDefinitionRegistry* Get();
+
+	void BuildIndexIfNeeded();
+
+	TArray<FSoftObjectPath> DefinitionPaths;
+	TArray<TWeakObjectPtr<UItemDefinitionDataAsset>> ResolvedDefinitions;
+	TMap<FName, uint16> NetIndexByItemId;
+	TSet<FName> WarnedUnregisteredItemIds;
+	bool bIndexBuilt = false;
+};
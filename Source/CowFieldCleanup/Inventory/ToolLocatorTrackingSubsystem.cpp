@@ -0,0 +1,157 @@
+#include "Inventory/ToolLocatorTrackingSubsystem.h"
+
+#include "Engine/World.h"
+#include "Inventory/DroppedToolRegistrySubsystem.h"
+#include "Inventory/InventoryComponent.h"
+#include "Inventory/InventoryStats.h"
+
+DECLARE_CYCLE_STAT(TEXT("LocatorTrackingPass"), STAT_InventoryLocatorTrackingPass, STATGROUP_Inventory);
+
+uint8 UToolLocatorTrackingSubsystem::QuantizeDirection(const FVector& Offset)
+{
+	const float YawDegrees = FMath::RadiansToDegrees(FMath::Atan2(Offset.Y, Offset.X));
+	const float SectorSize = 360.0f / DirectionSectors;
+	const int32 Sector = FMath::RoundToInt32(FRotator::ClampAxis(YawDegrees) / SectorSize) % DirectionSectors;
+	return static_cast<uint8>(Sector);
+}
+
+float UToolLocatorTrackingSubsystem::GetDirectionSectorYaw(uint8 DirectionSector)
+{
+	return (DirectionSector % DirectionSectors) * (360.0f / DirectionSectors);
+}
+
+void UToolLocatorTrackingSubsystem::Deinitialize()
+{
+	Subscriptions.Reset();
+	SubscriptionIndexBySubscriber.Reset();
+	PendingUpdates.Reset();
+
+	Super::Deinitialize();
+}
+
+void UToolLocatorTrackingSubsystem::Tick(float DeltaTime)
+{
+	INVENTORY_SCOPE_CYCLE_COUNTER(STAT_InventoryLocatorTrackingPass);
+
+	Super::Tick(DeltaTime);
+
+	const UWorld* World = GetWorld();
+	const UDroppedToolRegistrySubsystem* ToolRegistry = World->GetSubsystem<UDroppedToolRegistrySubsystem>();
+	const double CurrentTimeSeconds = World->GetTimeSeconds();
+
+	for (int32 SubscriptionIndex = Subscriptions.Num() - 1; SubscriptionIndex >= 0; --SubscriptionIndex)
+	{
+		FLocatorSubscription& Subscription = Subscriptions[SubscriptionIndex];
+		UInventoryComponent* Subscriber = Subscription.Subscriber.Get();
+		if (!Subscriber)
+		{
+			RemoveSubscriptionAt(SubscriptionIndex);
+			continue;
+		}
+
+		if (CurrentTimeSeconds < Subscription.NextEvaluationSeconds)
+		{
+			continue;
+		}
+
+		const FTrackedTool* TrackedTool = ToolRegistry ? ToolRegistry->FindTool(Subscription.ToolId) : nullptr;
+		if (!TrackedTool || !TrackedTool->bIsDropped)
+		{
+			PendingUpdates.Add({ Subscriber, Subscription.ToolId, ELocatorDistanceBand::Unknown, 0, 0 });
+			RemoveSubscriptionAt(SubscriptionIndex);
+			continue;
+		}
+
+		const FInventoryBalanceProfile& Profile = *Subscriber->BalanceProfile;
+		const FVector Offset = TrackedTool->WorldLocation - Subscriber->GetOwnerLocation();
+		const float DistanceSquared = Offset.SizeSquared();
+		const ELocatorDistanceBand DistanceBand = Profile.ResolveDistanceBandSquared(DistanceSquared);
+		const uint8 DirectionSector = QuantizeDirection(Offset);
+
+		const bool bChanged = !Subscription.bHasSent || DistanceBand != Subscription.LastDistanceBand || DirectionSector != Subscription.LastDirectionSector;
+		const bool bKeepAliveDue = (CurrentTimeSeconds - Subscription.LastSentSeconds) >= Profile.LocatorTrackingKeepAliveSeconds;
+		if (bChanged || bKeepAliveDue)
+		{
+			const uint16 DistanceMeters = static_cast<uint16>(FMath::Min(FMath::Sqrt(DistanceSquared) / 100.0f, static_cast<float>(MAX_uint16)));
+			PendingUpdates.Add({ Subscriber, Subscription.ToolId, DistanceBand, DirectionSector, DistanceMeters });
+
+			Subscription.LastDistanceBand = DistanceBand;
+			Subscription.LastDirectionSector = DirectionSector;
+			Subscription.LastSentSeconds = CurrentTimeSeconds;
+			Subscription.bHasSent = true;
+		}
+
+		Subscription.NextEvaluationSeconds = CurrentTimeSeconds + Profile.GetLocatorTrackingInterval(DistanceBand);
+	}
+
+	// Sent after the pass so a host-local handler that stops tracking cannot reshuffle Subscriptions mid-iteration.
+	for (const FPendingUpdate& Update : PendingUpdates)
+	{
+		if (UInventoryComponent* Subscriber = Update.Subscriber.Get())
+		{
+			Subscriber->ClientReceiveLocatorTracking(Update.ToolId, Update.DistanceBand, Update.DirectionSector, Update.DistanceMeters);
+		}
+	}
+	PendingUpdates.Reset();
+}
+
+bool UToolLocatorTrackingSubsystem::IsTickable() const
+{
+	return !Subscriptions.IsEmpty();
+}
+
+TStatId UToolLocatorTrackingSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UToolLocatorTrackingSubsystem, STATGROUP_Inventory);
+}
+
+void UToolLocatorTrackingSubsystem::Subscribe(UInventoryComponent* Subscriber, const FGuid& ToolId)
+{
+	if (!Subscriber || !ToolId.IsValid())
+	{
+		return;
+	}
+
+	LLM_SCOPE_BYTAG(Inventory);
+
+	FLocatorSubscription* Subscription = nullptr;
+	if (const int32* ExistingIndex = SubscriptionIndexBySubscriber.Find(Subscriber))
+	{
+		Subscription = &Subscriptions[*ExistingIndex];
+	}
+	else
+	{
+		SubscriptionIndexBySubscriber.Add(Subscriber, Subscriptions.Num());
+		Subscription = &Subscriptions.AddDefaulted_GetRef();
+		Subscription->Subscriber = Subscriber;
+		Subscription->SubscriberKey = Subscriber;
+	}
+
+	Subscription->ToolId = ToolId;
+	Subscription->NextEvaluationSeconds = 0.0;
+	Subscription->bHasSent = false;
+}
+
+void UToolLocatorTrackingSubsystem::Unsubscribe(const UInventoryComponent* Subscriber)
+{
+	if (const int32* ExistingIndex = SubscriptionIndexBySubscriber.Find(Subscriber))
+	{
+		RemoveSubscriptionAt(*ExistingIndex);
+	}
+}
+
+int32 UToolLocatorTrackingSubsystem::GetNumSubscriptions() const
+{
+	return Subscriptions.Num();
+}
+
+void UToolLocatorTrackingSubsystem::RemoveSubscriptionAt(int32 SubscriptionIndex)
+{
+	SubscriptionIndexBySubscriber.Remove(Subscriptions[SubscriptionIndex].SubscriberKey);
+
+	Subscriptions.RemoveAtSwap(SubscriptionIndex, 1, EAllowShrinking::No);
+	if (Subscriptions.IsValidIndex(SubscriptionIndex))
+	{
+		SubscriptionIndexBySubscriber.FindChecked(Subscriptions[SubscriptionIndex].SubscriberKey) = SubscriptionIndex;
+	}
+}
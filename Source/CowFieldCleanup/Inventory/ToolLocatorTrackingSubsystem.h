@@ -0,0 +1,60 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Inventory/InventoryTypes.h"
+#include "UObject/ObjectKey.h"
+#include "ToolLocatorTrackingSubsystem.generated.h"
+
+class UInventoryComponent;
+
+// Server-side hot/cold locator: evaluates every active tracking subscription in one pass per
+// frame, each at a band-dependent interval, and only sends band or direction changes.
+UCLASS()
+class COWFIELDCLEANUP_API UToolLocatorTrackingSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	static constexpr int32 DirectionSectors = 16;
+
+	static uint8 QuantizeDirection(const FVector& Offset);
+	static float GetDirectionSectorYaw(uint8 DirectionSector);
+
+	virtual void Deinitialize() override;
+	virtual void Tick(float DeltaTime) override;
+	virtual bool IsTickable() const override;
+	virtual TStatId GetStatId() const override;
+
+	void Subscribe(UInventoryComponent* Subscriber, const FGuid& ToolId);
+	void Unsubscribe(const UInventoryComponent* Subscriber);
+	int32 GetNumSubscriptions() const;
+
+private:
+	struct FLocatorSubscription
+	{
+		TWeakObjectPtr<UInventoryComponent> Subscriber;
+		TObjectKey<UInventoryComponent> SubscriberKey;
+		FGuid ToolId;
+		double NextEvaluationSeconds = 0.0;
+		double LastSentSeconds = 0.0;
+		ELocatorDistanceBand LastDistanceBand = ELocatorDistanceBand::Unknown;
+		uint8 LastDirectionSector = 0;
+		bool bHasSent = false;
+	};
+
+	struct FPendingUpdate
+	{
+		TWeakObjectPtr<UInventoryComponent> Subscriber;
+		FGuid ToolId;
+		ELocatorDistanceBand DistanceBand = ELocatorDistanceBand::Unknown;
+		uint8 DirectionSector = 0;
+		uint16 DistanceMeters = 0;
+	};
+
+	void RemoveSubscriptionAt(int32 SubscriptionIndex);
+
+	TArray<FLocatorSubscription> Subscriptions;
+	TArray<FPendingUpdate> PendingUpdates;
+	TMap<TObjectKey<UInventoryComponent>, int32> SubscriptionIndexBySubscriber;
+};
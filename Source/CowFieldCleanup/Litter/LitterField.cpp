@@ -0,0 +1,579 @@
+#include "Litter/LitterField.h"
+
+#include "Components/HierarchicalInstancedStaticMeshComponent.h"
+#include "Components/SceneComponent.h"
+#include "DataAssets/ItemDefinitionDataAsset.h"
+#include "Engine/GameInstance.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/World.h"
+#include "GameFramework/Pawn.h"
+#include "GameFramework/PlayerController.h"
+#include "Inventory/InventoryAssetPreloadSubsystem.h"
+#include "Inventory/InventoryStats.h"
+#include "Litter/LitterPickupActor.h"
+#include "Litter/LitterPlacementGenerator.h"
+#include "Net/Core/PushModel/PushModel.h"
+#include "Net/UnrealNetwork.h"
+
+DECLARE_CYCLE_STAT(TEXT("LitterPromotion"), STAT_LitterPromotion, STATGROUP_Inventory);
+DECLARE_CYCLE_STAT(TEXT("LitterRebuildRepresentation"), STAT_LitterRebuildRepresentation, STATGROUP_Inventory);
+
+ALitterField::ALitterField()
+{
+	PrimaryActorTick.bCanEverTick = true;
+	PrimaryActorTick.bStartWithTickEnabled = false;
+	bReplicates = true;
+	bAlwaysRelevant = true;
+	SetReplicatingMovement(false);
+	SetCanBeDamaged(false);
+
+	RootComponent = CreateDefaultSubobject<USceneComponent>(TEXT("Root"));
+	PickupActorClass = ALitterPickupActor::StaticClass();
+}
+
+void ALitterField::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
+{
+	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
+
+	FDoRepLifetimeParams SharedParams;
+	SharedParams.bIsPushBased = true;
+
+	DOREPLIFETIME_WITH_PARAMS_FAST(ALitterField, GenerationParams, SharedParams); // Generated fields only send their seed and inputs
+	DOREPLIFETIME_WITH_PARAMS_FAST(ALitterField, LitterDefinitions, SharedParams); // Item definition palette for authored Placements
+	DOREPLIFETIME_WITH_PARAMS_FAST(ALitterField, Placements, SharedParams); // Authored fields only, sent once
+	DOREPLIFETIME_WITH_PARAMS_FAST(ALitterField, CollectedLitterBits, SharedParams); // One bit per placement
+}
+
+void ALitterField::BeginPlay()
+{
+	Super::BeginPlay();
+
+	if (!LitterPlacements.IsEmpty())
+	{
+		RebuildRepresentation();
+	}
+}
+
+void ALitterField::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	ReleasePromotedActors();
+	for (ALitterPickupActor* PooledActor : PooledActors)
+	{
+		if (PooledActor)
+		{
+			PooledActor->Destroy();
+		}
+	}
+	PooledActors.Reset();
+
+	Super::EndPlay(EndPlayReason);
+}
+
+void ALitterField::Tick(float DeltaSeconds)
+{
+	Super::Tick(DeltaSeconds);
+
+	PromotionAccumulatorSeconds += DeltaSeconds;
+	if (PromotionAccumulatorSeconds >= PromotionIntervalSeconds)
+	{
+		PromotionAccumulatorSeconds = 0.0f;
+		UpdatePromotion();
+	}
+
+	if (bInstancesDirty)
+	{
+		for (UHierarchicalInstancedStaticMeshComponent* InstanceComponent : InstanceComponents)
+		{
+			if (InstanceComponent)
+			{
+				InstanceComponent->MarkRenderStateDirty();
+			}
+		}
+		bInstancesDirty = false;
+	}
+}
+
+void ALitterField::PostNetReceive()
+{
+	Super::PostNetReceive();
+
+	if (bLitterRefreshPending)
+	{
+		bLitterRefreshPending = false;
+		RefreshLitter();
+	}
+}
+
+void ALitterField::InitializeLitter(TArray<TObjectPtr<UItemDefinitionDataAsset>> InLitterDefinitions, TArray<FLitterPlacement> InPlacements)
+{
+	if (!HasAuthority())
+	{
+		return;
+	}
+
+	GenerationParams = FLitterFieldParams();
+	LitterDefinitions = MoveTemp(InLitterDefinitions);
+	Placements = MoveTemp(InPlacements);
+	Placements.RemoveAllSwap([this](const FLitterPlacement& Placement)
+	{
+		return !LitterDefinitions.IsValidIndex(Placement.DefinitionIndex) || !LitterDefinitions[Placement.DefinitionIndex];
+	});
+
+	MARK_PROPERTY_DIRTY_FROM_NAME(ALitterField, GenerationParams, this);
+	MARK_PROPERTY_DIRTY_FROM_NAME(ALitterField, LitterDefinitions, this);
+	MARK_PROPERTY_DIRTY_FROM_NAME(ALitterField, Placements, this);
+	ResetCollectedLitter();
+}
+
+void ALitterField::InitializeGeneratedLitter(const FLitterFieldParams& Params)
+{
+	if (!HasAuthority())
+	{
+		return;
+	}
+
+	GenerationParams = Params;
+	LitterDefinitions.Reset();
+	Placements.Reset();
+
+	MARK_PROPERTY_DIRTY_FROM_NAME(ALitterField, GenerationParams, this);
+	MARK_PROPERTY_DIRTY_FROM_NAME(ALitterField, LitterDefinitions, this);
+	MARK_PROPERTY_DIRTY_FROM_NAME(ALitterField, Placements, this);
+	ResetCollectedLitter();
+}
+
+void ALitterField::ResetCollectedLitter()
+{
+	CollectedLitterBits.Reset();
+	RefreshLitter();
+
+	CollectedLitterBits.SetNumZeroed(FMath::DivideAndRoundUp(LitterPlacements.Num(), 32));
+	MARK_PROPERTY_DIRTY_FROM_NAME(ALitterField, CollectedLitterBits, this);
+}
+
+void ALitterField::RefreshLitter()
+{
+	// Generated fields are rebuilt from the replicated seed on every machine, so only the inputs cross the wire.
+	if (GenerationParams.IsValid())
+	{
+		LitterPalette.Reset(GenerationParams.ItemWeights.Num());
+		for (const FLitterSpawnWeight& ItemWeight : GenerationParams.ItemWeights)
+		{
+			LitterPalette.Add(ItemWeight.ItemDefinition);
+		}
+		FLitterPlacementGenerator::Generate(GenerationParams, LitterPlacements);
+	}
+	else
+	{
+		LitterPalette = LitterDefinitions;
+		LitterPlacements = Placements;
+	}
+
+	if (HasActorBegunPlay())
+	{
+		RebuildRepresentation();
+	}
+}
+
+UItemDefinitionDataAsset* ALitterField::FindCollectableLitter(int32 LitterIndex, const FVector& Location) const
+{
+	if (!LitterPlacements.IsValidIndex(LitterIndex) || IsLitterCollected(LitterIndex))
+	{
+		return nullptr;
+	}
+
+	const FLitterPlacement& Placement = LitterPlacements[LitterIndex];
+	if (FVector::DistSquared(FVector(Placement.Location), Location) > FMath::Square(PickupRange))
+	{
+		return nullptr;
+	}
+
+	return LitterPalette[Placement.DefinitionIndex];
+}
+
+void ALitterField::MarkLitterCollected(int32 LitterIndex)
+{
+	if (!HasAuthority() || !LitterPlacements.IsValidIndex(LitterIndex) || IsLitterCollected(LitterIndex))
+	{
+		return;
+	}
+
+	CollectedLitterBits[LitterIndex / 32] |= 1u << (LitterIndex % 32);
+	MARK_PROPERTY_DIRTY_FROM_NAME(ALitterField, CollectedLitterBits, this);
+	ApplyLitterCollected(LitterIndex);
+}
+
+bool ALitterField::IsLitterCollected(int32 LitterIndex) const
+{
+	const int32 WordIndex = LitterIndex / 32;
+	return LitterIndex >= 0 && CollectedLitterBits.IsValidIndex(WordIndex) && (CollectedLitterBits[WordIndex] & (1u << (LitterIndex % 32))) != 0;
+}
+
+int32 ALitterField::GetNumLitter() const
+{
+	return LitterPlacements.Num();
+}
+
+int32 ALitterField::GetNumRemainingLitter() const
+{
+	return LitterPlacements.Num() - NumCollectedLitter;
+}
+
+int32 ALitterField::GetNumPromotedLitter() const
+{
+	return PromotedActors.Num();
+}
+
+void ALitterField::OnRep_Litter()
+{
+	bLitterRefreshPending = true;
+}
+
+void ALitterField::OnRep_CollectedLitterBits()
+{
+	ApplyCollectedBits();
+}
+
+bool ALitterField::IsRepresentationVisible() const
+{
+	return GetNetMode() != NM_DedicatedServer;
+}
+
+void ALitterField::RebuildRepresentation()
+{
+	INVENTORY_SCOPE_CYCLE_COUNTER(STAT_LitterRebuildRepresentation);
+
+	ReleasePromotedActors();
+	for (UHierarchicalInstancedStaticMeshComponent* InstanceComponent : InstanceComponents)
+	{
+		if (InstanceComponent)
+		{
+			InstanceComponent->DestroyComponent();
+		}
+	}
+	InstanceComponents.Reset();
+	DisplacedLitter.Reset();
+
+	const int32 NumLitter = LitterPlacements.Num();
+	InstanceIndexByLitter.Init(INDEX_NONE, NumLitter);
+	AppliedCollectedLitter.Init(false, NumLitter);
+	PromotedLitter.Init(false, NumLitter);
+	NumCollectedLitter = 0;
+
+	if (!IsRepresentationVisible())
+	{
+		ApplyCollectedBits();
+		return;
+	}
+
+	// Meshes come in with the "Field" bundle; wait for the preload rather than hitching on a sync load.
+	const UGameInstance* GameInstance = GetGameInstance();
+	UInventoryAssetPreloadSubsystem* PreloadSubsystem = GameInstance ? GameInstance->GetSubsystem<UInventoryAssetPreloadSubsystem>() : nullptr;
+	for (const UItemDefinitionDataAsset* Definition : LitterPalette)
+	{
+		if (!Definition || Definition->WorldMesh.IsNull() || Definition->WorldMesh.IsValid())
+		{
+			continue;
+		}
+
+		if (PreloadSubsystem && !PreloadSubsystem->IsPreloadComplete())
+		{
+			ApplyCollectedBits();
+			PreloadSubsystem->CallWhenPreloaded(FSimpleDelegate::CreateWeakLambda(this, [this]()
+			{
+				RebuildRepresentation();
+			}));
+			return;
+		}
+
+		Definition->WorldMesh.LoadSynchronous();
+	}
+
+	BuildCells();
+
+	TArray<TArray<FTransform>> TransformsByDefinition;
+	TArray<TArray<int32>> LitterByDefinition;
+	TransformsByDefinition.SetNum(LitterPalette.Num());
+	LitterByDefinition.SetNum(LitterPalette.Num());
+	for (int32 LitterIndex = 0; LitterIndex < NumLitter; ++LitterIndex)
+	{
+		const int32 DefinitionIndex = LitterPlacements[LitterIndex].DefinitionIndex;
+		if (LitterPalette.IsValidIndex(DefinitionIndex))
+		{
+			TransformsByDefinition[DefinitionIndex].Add(GetLitterTransform(LitterIndex));
+			LitterByDefinition[DefinitionIndex].Add(LitterIndex);
+		}
+	}
+
+	InstanceComponents.SetNumZeroed(LitterPalette.Num());
+	for (int32 DefinitionIndex = 0; DefinitionIndex < LitterPalette.Num(); ++DefinitionIndex)
+	{
+		const UItemDefinitionDataAsset* Definition = LitterPalette[DefinitionIndex];
+		UStaticMesh* Mesh = Definition ? Definition->WorldMesh.Get() : nullptr;
+		if (!Mesh || TransformsByDefinition[DefinitionIndex].IsEmpty())
+		{
+			continue;
+		}
+
+		UHierarchicalInstancedStaticMeshComponent* InstanceComponent = NewObject<UHierarchicalInstancedStaticMeshComponent>(this);
+		InstanceComponent->SetStaticMesh(Mesh);
+		InstanceComponent->SetMobility(EComponentMobility::Movable);
+		InstanceComponent->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+		InstanceComponent->SetCullDistances(0, FMath::RoundToInt32(InstanceCullDistance));
+		InstanceComponent->SetupAttachment(RootComponent);
+		InstanceComponent->RegisterComponent();
+
+		const TArray<int32> InstanceIndices = InstanceComponent->AddInstances(TransformsByDefinition[DefinitionIndex], true, true);
+		const TArray<int32>& DefinitionLitter = LitterByDefinition[DefinitionIndex];
+		for (int32 Index = 0; Index < InstanceIndices.Num() && Index < DefinitionLitter.Num(); ++Index)
+		{
+			InstanceIndexByLitter[DefinitionLitter[Index]] = InstanceIndices[Index];
+		}
+
+		InstanceComponents[DefinitionIndex] = InstanceComponent;
+	}
+
+	ApplyCollectedBits();
+	SetActorTickEnabled(true);
+}
+
+void ALitterField::BuildCells()
+{
+	CellSize = FMath::Max(PromotionRadius, 100.0f);
+	CellRanges.Reset();
+	LitterByCell.SetNumUninitialized(LitterPlacements.Num());
+
+	TArray<FIntPoint> LitterCells;
+	LitterCells.SetNumUninitialized(LitterPlacements.Num());
+	for (int32 LitterIndex = 0; LitterIndex < LitterPlacements.Num(); ++LitterIndex)
+	{
+		LitterCells[LitterIndex] = GetCellForLocation(FVector(LitterPlacements[LitterIndex].Location));
+		++CellRanges.FindOrAdd(LitterCells[LitterIndex]).Num;
+	}
+
+	int32 FirstInCell = 0;
+	for (TPair<FIntPoint, FCellRange>& CellPair : CellRanges)
+	{
+		CellPair.Value.First = FirstInCell;
+		FirstInCell += CellPair.Value.Num;
+		CellPair.Value.Num = 0;
+	}
+
+	for (int32 LitterIndex = 0; LitterIndex < LitterPlacements.Num(); ++LitterIndex)
+	{
+		FCellRange& CellRange = CellRanges.FindChecked(LitterCells[LitterIndex]);
+		LitterByCell[CellRange.First + CellRange.Num++] = LitterIndex;
+	}
+}
+
+FIntPoint ALitterField::GetCellForLocation(const FVector& Location) const
+{
+	return FIntPoint(FMath::FloorToInt32(Location.X / CellSize), FMath::FloorToInt32(Location.Y / CellSize));
+}
+
+FTransform ALitterField::GetLitterTransform(int32 LitterIndex) const
+{
+	if (const FTransform* Displaced = DisplacedLitter.Find(LitterIndex))
+	{
+		return *Displaced;
+	}
+
+	const FLitterPlacement& Placement = LitterPlacements[LitterIndex];
+	return FTransform(FRotator(0.0f, Placement.Yaw, 0.0f), FVector(Placement.Location));
+}
+
+void ALitterField::SetInstanceVisible(int32 LitterIndex, bool bVisible)
+{
+	const int32 InstanceIndex = InstanceIndexByLitter.IsValidIndex(LitterIndex) ? InstanceIndexByLitter[LitterIndex] : INDEX_NONE;
+	UHierarchicalInstancedStaticMeshComponent* InstanceComponent = InstanceIndex != INDEX_NONE ? InstanceComponents[LitterPlacements[LitterIndex].DefinitionIndex].Get() : nullptr;
+	if (!InstanceComponent)
+	{
+		return;
+	}
+
+	// Hidden instances are collapsed in place instead of removed so instance indices never shift.
+	FTransform InstanceTransform = GetLitterTransform(LitterIndex);
+	if (!bVisible)
+	{
+		InstanceTransform.SetScale3D(FVector::ZeroVector);
+	}
+
+	InstanceComponent->UpdateInstanceTransform(InstanceIndex, InstanceTransform, true, false, true);
+	bInstancesDirty = true;
+}
+
+void ALitterField::ApplyCollectedBits()
+{
+	const int32 NumLitter = FMath::Min(LitterPlacements.Num(), AppliedCollectedLitter.Num());
+	for (int32 WordIndex = 0; WordIndex < CollectedLitterBits.Num(); ++WordIndex)
+	{
+		const uint32 CollectedWord = CollectedLitterBits[WordIndex];
+		if (CollectedWord == 0)
+		{
+			continue;
+		}
+
+		const int32 FirstInWord = WordIndex * 32;
+		for (int32 LitterIndex = FirstInWord; LitterIndex < FirstInWord + 32 && LitterIndex < NumLitter; ++LitterIndex)
+		{
+			if ((CollectedWord & (1u << (LitterIndex - FirstInWord))) != 0)
+			{
+				ApplyLitterCollected(LitterIndex);
+			}
+		}
+	}
+}
+
+void ALitterField::ApplyLitterCollected(int32 LitterIndex)
+{
+	if (!AppliedCollectedLitter.IsValidIndex(LitterIndex) || AppliedCollectedLitter[LitterIndex])
+	{
+		return;
+	}
+
+	AppliedCollectedLitter[LitterIndex] = true;
+	++NumCollectedLitter;
+
+	if (PromotedLitter[LitterIndex])
+	{
+		DemoteLitter(LitterIndex);
+	}
+	SetInstanceVisible(LitterIndex, false);
+}
+
+void ALitterField::UpdatePromotion()
+{
+	INVENTORY_SCOPE_CYCLE_COUNTER(STAT_LitterPromotion);
+
+	ViewerLocations.Reset();
+	for (FConstPlayerControllerIterator Iterator = GetWorld()->GetPlayerControllerIterator(); Iterator; ++Iterator)
+	{
+		const APlayerController* PlayerController = Iterator->Get();
+		const APawn* Pawn = PlayerController && PlayerController->IsLocalController() ? PlayerController->GetPawn() : nullptr;
+		if (Pawn)
+		{
+			ViewerLocations.Add(Pawn->GetActorLocation());
+		}
+	}
+
+	const float DemotionRadiusSquared = FMath::Square(FMath::Max(DemotionRadius, PromotionRadius));
+	for (int32 PromotedIndex = PromotedActors.Num() - 1; PromotedIndex >= 0; --PromotedIndex)
+	{
+		const ALitterPickupActor* PromotedActor = PromotedActors[PromotedIndex];
+		const FVector ActorLocation = PromotedActor->GetActorLocation();
+		const bool bNearViewer = ViewerLocations.ContainsByPredicate([&ActorLocation, DemotionRadiusSquared](const FVector& ViewerLocation)
+		{
+			return FVector::DistSquared(ViewerLocation, ActorLocation) <= DemotionRadiusSquared;
+		});
+
+		if (!bNearViewer && !PromotedActor->IsBodyAwake())
+		{
+			DemoteLitter(PromotedActor->GetLitterIndex());
+		}
+	}
+
+	const float PromotionRadiusSquared = FMath::Square(PromotionRadius);
+	const int32 CellRadius = FMath::CeilToInt32(PromotionRadius / CellSize);
+	for (const FVector& ViewerLocation : ViewerLocations)
+	{
+		const FIntPoint ViewerCell = GetCellForLocation(ViewerLocation);
+		for (int32 CellY = ViewerCell.Y - CellRadius; CellY <= ViewerCell.Y + CellRadius; ++CellY)
+		{
+			for (int32 CellX = ViewerCell.X - CellRadius; CellX <= ViewerCell.X + CellRadius; ++CellX)
+			{
+				const FCellRange* CellRange = CellRanges.Find(FIntPoint(CellX, CellY));
+				if (!CellRange)
+				{
+					continue;
+				}
+
+				for (int32 Index = CellRange->First; Index < CellRange->First + CellRange->Num; ++Index)
+				{
+					const int32 LitterIndex = LitterByCell[Index];
+					if (PromotedActors.Num() >= MaxPromotedLitter)
+					{
+						return;
+					}
+
+					if (PromotedLitter[LitterIndex] || AppliedCollectedLitter[LitterIndex] || InstanceIndexByLitter[LitterIndex] == INDEX_NONE)
+					{
+						continue;
+					}
+
+					if (FVector::DistSquared(GetLitterTransform(LitterIndex).GetLocation(), ViewerLocation) <= PromotionRadiusSquared)
+					{
+						PromoteLitter(LitterIndex);
+					}
+				}
+			}
+		}
+	}
+}
+
+void ALitterField::PromoteLitter(int32 LitterIndex)
+{
+	ALitterPickupActor* PickupActor = nullptr;
+	if (!PooledActors.IsEmpty())
+	{
+		PickupActor = PooledActors.Pop(EAllowShrinking::No);
+	}
+	else
+	{
+		FActorSpawnParameters SpawnParameters;
+		SpawnParameters.Owner = this;
+		SpawnParameters.ObjectFlags |= RF_Transient;
+		SpawnParameters.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+		PickupActor = GetWorld()->SpawnActor<ALitterPickupActor>(PickupActorClass ? PickupActorClass.Get() : ALitterPickupActor::StaticClass(), GetLitterTransform(LitterIndex), SpawnParameters);
+	}
+
+	if (!PickupActor)
+	{
+		return;
+	}
+
+	const UItemDefinitionDataAsset* Definition = LitterPalette[LitterPlacements[LitterIndex].DefinitionIndex];
+	PickupActor->Activate(this, LitterIndex, Definition->WorldMesh.Get(), GetLitterTransform(LitterIndex));
+	PromotedActors.Add(PickupActor);
+	PromotedLitter[LitterIndex] = true;
+	SetInstanceVisible(LitterIndex, false);
+}
+
+void ALitterField::DemoteLitter(int32 LitterIndex)
+{
+	const int32 PromotedIndex = PromotedActors.IndexOfByPredicate([LitterIndex](const ALitterPickupActor* Candidate) { return Candidate->GetLitterIndex() == LitterIndex; });
+	if (PromotedIndex == INDEX_NONE)
+	{
+		return;
+	}
+
+	ALitterPickupActor* PickupActor = PromotedActors[PromotedIndex];
+	const FTransform ActorTransform = PickupActor->GetActorTransform();
+	if (!ActorTransform.Equals(GetLitterTransform(LitterIndex), 1.0f))
+	{
+		DisplacedLitter.Add(LitterIndex, ActorTransform);
+	}
+
+	PickupActor->Deactivate();
+	PooledActors.Add(PickupActor);
+	PromotedActors.RemoveAtSwap(PromotedIndex, 1, EAllowShrinking::No);
+	PromotedLitter[LitterIndex] = false;
+
+	if (!AppliedCollectedLitter[LitterIndex])
+	{
+		SetInstanceVisible(LitterIndex, true);
+	}
+}
+
+void ALitterField::ReleasePromotedActors()
+{
+	for (ALitterPickupActor* PickupActor : PromotedActors)
+	{
+		if (PickupActor)
+		{
+			PickupActor->Deactivate();
+			PooledActors.Add(PickupActor);
+		}
+	}
+	PromotedActors.Reset();
+	PromotedLitter.Init(false, PromotedLitter.Num());
+}
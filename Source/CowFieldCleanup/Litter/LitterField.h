@@ -0,0 +1,146 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/Actor.h"
+#include "Litter/LitterTypes.h"
+#include "LitterField.generated.h"
+
+class ALitterPickupActor;
+class UHierarchicalInstancedStaticMeshComponent;
+class UItemDefinitionDataAsset;
+
+// One procedurally generated field's cleanup items. Litter lives as plain records drawn through one
+// instanced mesh per item definition; only litter near a local player is promoted to a pooled
+// ALitterPickupActor for collision, physics and interaction. The server owns which litter has been
+// collected and replicates it as a bitset.
+UCLASS()
+class COWFIELDCLEANUP_API ALitterField : public AActor
+{
+	GENERATED_BODY()
+
+public:
+	ALitterField();
+
+	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
+	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+	virtual void Tick(float DeltaSeconds) override;
+	virtual void PostNetReceive() override;
+
+	// Server only. Replaces the field's litter with authored placements, which are replicated once.
+	void InitializeLitter(TArray<TObjectPtr<UItemDefinitionDataAsset>> InLitterDefinitions, TArray<FLitterPlacement> InPlacements);
+
+	// Server only. Replaces the field's litter with a generated layout; only Params are replicated and
+	// every machine runs the same generator.
+	UFUNCTION(BlueprintCallable, BlueprintAuthorityOnly, Category = "Litter")
+	void InitializeGeneratedLitter(const FLitterFieldParams& Params);
+
+	// Server only. Returns the litter's item definition if it is still lying in the field within PickupRange of Location.
+	UItemDefinitionDataAsset* FindCollectableLitter(int32 LitterIndex, const FVector& Location) const;
+
+	// Server only.
+	void MarkLitterCollected(int32 LitterIndex);
+
+	UFUNCTION(BlueprintPure, Category = "Litter")
+	bool IsLitterCollected(int32 LitterIndex) const;
+
+	UFUNCTION(BlueprintPure, Category = "Litter")
+	int32 GetNumLitter() const;
+
+	UFUNCTION(BlueprintPure, Category = "Litter")
+	int32 GetNumRemainingLitter() const;
+
+	int32 GetNumPromotedLitter() const;
+
+	// Litter within this distance of a local player is promoted to an actor.
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Litter|Representation", meta = (ClampMin = "0.0"))
+	float PromotionRadius = 600.0f;
+
+	// Promoted litter farther than this from every local player goes back to its instance once its body is asleep.
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Litter|Representation", meta = (ClampMin = "0.0"))
+	float DemotionRadius = 800.0f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Litter|Representation", meta = (ClampMin = "0"))
+	int32 MaxPromotedLitter = 64;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Litter|Representation", meta = (ClampMin = "0.0"))
+	float PromotionIntervalSeconds = 0.2f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Litter|Representation", meta = (ClampMin = "0.0"))
+	float InstanceCullDistance = 15000.0f;
+
+	// Measured from where the litter was generated, so leave slack for litter players have kicked around.
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Litter|Pickup", meta = (ClampMin = "0.0"))
+	float PickupRange = 500.0f;
+
+	UPROPERTY(EditAnywhere, Category = "Litter|Representation")
+	TSubclassOf<ALitterPickupActor> PickupActorClass;
+
+private:
+	struct FCellRange
+	{
+		int32 First = 0;
+		int32 Num = 0;
+	};
+
+	UFUNCTION()
+	void OnRep_Litter();
+
+	UFUNCTION()
+	void OnRep_CollectedLitterBits();
+
+	void ResetCollectedLitter();
+	void RefreshLitter();
+	bool IsRepresentationVisible() const;
+	void RebuildRepresentation();
+	void BuildCells();
+	FIntPoint GetCellForLocation(const FVector& Location) const;
+	FTransform GetLitterTransform(int32 LitterIndex) const;
+	void SetInstanceVisible(int32 LitterIndex, bool bVisible);
+	void ApplyCollectedBits();
+	void ApplyLitterCollected(int32 LitterIndex);
+	void UpdatePromotion();
+	void PromoteLitter(int32 LitterIndex);
+	void DemoteLitter(int32 LitterIndex);
+	void ReleasePromotedActors();
+
+	UPROPERTY(ReplicatedUsing = OnRep_Litter)
+	FLitterFieldParams GenerationParams;
+
+	UPROPERTY(ReplicatedUsing = OnRep_Litter)
+	TArray<TObjectPtr<UItemDefinitionDataAsset>> LitterDefinitions;
+
+	UPROPERTY(ReplicatedUsing = OnRep_Litter)
+	TArray<FLitterPlacement> Placements;
+
+	UPROPERTY(ReplicatedUsing = OnRep_CollectedLitterBits)
+	TArray<uint32> CollectedLitterBits;
+
+	// What the field is actually showing, from either GenerationParams or the authored arrays.
+	UPROPERTY(Transient)
+	TArray<TObjectPtr<UItemDefinitionDataAsset>> LitterPalette;
+
+	TArray<FLitterPlacement> LitterPlacements;
+
+	UPROPERTY(Transient)
+	TArray<TObjectPtr<UHierarchicalInstancedStaticMeshComponent>> InstanceComponents;
+
+	UPROPERTY(Transient)
+	TArray<TObjectPtr<ALitterPickupActor>> PromotedActors;
+
+	UPROPERTY(Transient)
+	TArray<TObjectPtr<ALitterPickupActor>> PooledActors;
+
+	TArray<int32> InstanceIndexByLitter;
+	TMap<int32, FTransform> DisplacedLitter;
+	TBitArray<> AppliedCollectedLitter;
+	TBitArray<> PromotedLitter;
+	TArray<int32> LitterByCell;
+	TMap<FIntPoint, FCellRange> CellRanges;
+	TArray<FVector, TInlineAllocator<4>> ViewerLocations;
+	float CellSize = 1000.0f;
+	float PromotionAccumulatorSeconds = 0.0f;
+	int32 NumCollectedLitter = 0;
+	bool bInstancesDirty = false;
+	bool bLitterRefreshPending = false;
+};
@@ -0,0 +1,60 @@
+#include "Litter/LitterPickupActor.h"
+
+#include "Components/StaticMeshComponent.h"
+#include "Engine/CollisionProfile.h"
+#include "Engine/StaticMesh.h"
+#include "Litter/LitterField.h"
+
+ALitterPickupActor::ALitterPickupActor()
+{
+	PrimaryActorTick.bCanEverTick = false;
+	bReplicates = false;
+	SetCanBeDamaged(false);
+
+	MeshComponent = CreateDefaultSubobject<UStaticMeshComponent>(TEXT("Mesh"));
+	MeshComponent->SetCollisionProfileName(UCollisionProfile::PhysicsActor_ProfileName);
+	MeshComponent->SetGenerateOverlapEvents(false);
+	RootComponent = MeshComponent;
+}
+
+void ALitterPickupActor::Activate(ALitterField* InLitterField, int32 InLitterIndex, UStaticMesh* Mesh, const FTransform& Transform)
+{
+	LitterField = InLitterField;
+	LitterIndex = InLitterIndex;
+
+	MeshComponent->SetStaticMesh(Mesh);
+	SetActorTransform(Transform, false, nullptr, ETeleportType::ResetPhysics);
+	SetActorHiddenInGame(false);
+	SetActorEnableCollision(true);
+	MeshComponent->SetSimulatePhysics(bSimulatePhysicsWhenPromoted);
+	if (bSimulatePhysicsWhenPromoted)
+	{
+		// Litter starts at rest; it only wakes when something touches it.
+		MeshComponent->PutRigidBodyToSleep();
+	}
+}
+
+void ALitterPickupActor::Deactivate()
+{
+	MeshComponent->SetSimulatePhysics(false);
+	SetActorEnableCollision(false);
+	SetActorHiddenInGame(true);
+
+	LitterField.Reset();
+	LitterIndex = INDEX_NONE;
+}
+
+bool ALitterPickupActor::IsBodyAwake() const
+{
+	return MeshComponent->IsSimulatingPhysics() && MeshComponent->RigidBodyIsAwake();
+}
+
+ALitterField* ALitterPickupActor::GetLitterField() const
+{
+	return LitterField.Get();
+}
+
+int32 ALitterPickupActor::GetLitterIndex() const
+{
+	return LitterIndex;
+}
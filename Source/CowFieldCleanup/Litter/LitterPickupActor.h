@@ -0,0 +1,41 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/Actor.h"
+#include "LitterPickupActor.generated.h"
+
+class ALitterField;
+class UStaticMesh;
+class UStaticMeshComponent;
+
+// Local, non-replicated stand-in for one litter record near a player. Pooled by ALitterField;
+// interaction code reads the field and index back off it to ask the server for the pickup.
+UCLASS()
+class COWFIELDCLEANUP_API ALitterPickupActor : public AActor
+{
+	GENERATED_BODY()
+
+public:
+	ALitterPickupActor();
+
+	void Activate(ALitterField* InLitterField, int32 InLitterIndex, UStaticMesh* Mesh, const FTransform& Transform);
+	void Deactivate();
+	bool IsBodyAwake() const;
+
+	UFUNCTION(BlueprintPure, Category = "Litter")
+	ALitterField* GetLitterField() const;
+
+	UFUNCTION(BlueprintPure, Category = "Litter")
+	int32 GetLitterIndex() const;
+
+	UPROPERTY(EditDefaultsOnly, Category = "Litter")
+	bool bSimulatePhysicsWhenPromoted = true;
+
+protected:
+	UPROPERTY(VisibleAnywhere, Category = "Litter")
+	TObjectPtr<UStaticMeshComponent> MeshComponent;
+
+private:
+	TWeakObjectPtr<ALitterField> LitterField;
+	int32 LitterIndex = INDEX_NONE;
+};
@@ -0,0 +1,128 @@
+#include "Litter/LitterPlacementGenerator.h"
+
+#include "Algo/UpperBound.h"
+#include "Async/ParallelFor.h"
+#include "Inventory/InventoryStats.h"
+#include "Math/RandomStream.h"
+
+DECLARE_CYCLE_STAT(TEXT("LitterPlacementGenerate"), STAT_LitterPlacementGenerate, STATGROUP_Inventory);
+
+namespace LitterPlacementGenerator
+{
+	// Weights are quantized so item selection is integer-only and cannot drift between compilers.
+	constexpr float WeightScale = 1024.0f;
+
+	static uint32 MixBits(uint32 Value)
+	{
+		Value ^= Value >> 16;
+		Value *= 0x85EBCA6Bu;
+		Value ^= Value >> 13;
+		Value *= 0xC2B2AE35u;
+		Value ^= Value >> 16;
+		return Value;
+	}
+
+	struct FTile
+	{
+		FVector2D Min;
+		FVector2D Size;
+		int32 Seed = 0;
+	};
+
+	static int32 DrawTileCount(FRandomStream& Stream, const FTile& Tile, float Density)
+	{
+		const double ExpectedCount = Density * (Tile.Size.X * Tile.Size.Y) / 10000.0;
+		const double WholeCount = FMath::FloorToDouble(ExpectedCount);
+		const bool bExtra = Stream.GetFraction() < static_cast<float>(ExpectedCount - WholeCount);
+		return static_cast<int32>(WholeCount) + (bExtra ? 1 : 0);
+	}
+}
+
+void FLitterPlacementGenerator::Generate(const FLitterFieldParams& Params, TArray<FLitterPlacement>& OutPlacements)
+{
+	using namespace LitterPlacementGenerator;
+
+	INVENTORY_SCOPE_CYCLE_COUNTER(STAT_LitterPlacementGenerate);
+
+	OutPlacements.Reset();
+	if (!Params.IsValid())
+	{
+		return;
+	}
+
+	TArray<uint32, TInlineAllocator<32>> CumulativeWeights;
+	uint32 TotalWeight = 0;
+	for (const FLitterSpawnWeight& ItemWeight : Params.ItemWeights)
+	{
+		const bool bUsable = ItemWeight.ItemDefinition && ItemWeight.Weight > 0.0f;
+		TotalWeight += bUsable ? static_cast<uint32>(FMath::Max(1, FMath::RoundToInt32(ItemWeight.Weight * WeightScale))) : 0;
+		CumulativeWeights.Add(TotalWeight);
+	}
+
+	const FVector2D FieldSize = Params.BoundsMax - Params.BoundsMin;
+	const int32 NumTilesX = FMath::Max(1, FMath::CeilToInt32(FieldSize.X / Params.TileSize));
+	const int32 NumTilesY = FMath::Max(1, FMath::CeilToInt32(FieldSize.Y / Params.TileSize));
+	if (static_cast<int64>(NumTilesX) * NumTilesY > MaxTiles)
+	{
+		return;
+	}
+
+	const int32 NumTiles = NumTilesX * NumTilesY;
+	TArray<FTile> Tiles;
+	Tiles.SetNumUninitialized(NumTiles);
+	for (int32 TileY = 0; TileY < NumTilesY; ++TileY)
+	{
+		for (int32 TileX = 0; TileX < NumTilesX; ++TileX)
+		{
+			FTile& Tile = Tiles[TileY * NumTilesX + TileX];
+			Tile.Min = Params.BoundsMin + FVector2D(TileX, TileY) * Params.TileSize;
+			Tile.Size = FVector2D::Min(FVector2D(Params.TileSize), Params.BoundsMax - Tile.Min);
+			Tile.Seed = GetTileSeed(Params.Seed, TileX, TileY);
+		}
+	}
+
+	// First pass draws each tile's count, then a prefix sum gives every tile its own output slice.
+	TArray<int32> TileOffsets;
+	TileOffsets.SetNumUninitialized(NumTiles + 1);
+	ParallelFor(NumTiles, [&Tiles, &TileOffsets, &Params](int32 TileIndex)
+	{
+		FRandomStream Stream(Tiles[TileIndex].Seed);
+		TileOffsets[TileIndex + 1] = DrawTileCount(Stream, Tiles[TileIndex], Params.Density);
+	});
+
+	TileOffsets[0] = 0;
+	for (int32 TileIndex = 0; TileIndex < NumTiles; ++TileIndex)
+	{
+		TileOffsets[TileIndex + 1] += TileOffsets[TileIndex];
+	}
+
+	OutPlacements.SetNumUninitialized(TileOffsets[NumTiles]);
+	ParallelFor(NumTiles, [&Tiles, &TileOffsets, &Params, &CumulativeWeights, TotalWeight, &OutPlacements](int32 TileIndex)
+	{
+		const FTile& Tile = Tiles[TileIndex];
+		FRandomStream Stream(Tile.Seed);
+		DrawTileCount(Stream, Tile, Params.Density);
+
+		for (int32 PlacementIndex = TileOffsets[TileIndex]; PlacementIndex < TileOffsets[TileIndex + 1]; ++PlacementIndex)
+		{
+			const double LocationX = Tile.Min.X + Stream.GetFraction() * Tile.Size.X;
+			const double LocationY = Tile.Min.Y + Stream.GetFraction() * Tile.Size.Y;
+			const uint32 WeightRoll = Stream.GetUnsignedInt() % TotalWeight;
+
+			FLitterPlacement& Placement = OutPlacements[PlacementIndex];
+			Placement.DefinitionIndex = Algo::UpperBound(CumulativeWeights, WeightRoll);
+			Placement.Location = FVector3f(static_cast<float>(LocationX), static_cast<float>(LocationY), Params.GroundZ);
+			Placement.Yaw = Stream.GetFraction() * 360.0f;
+		}
+	});
+}
+
+int32 FLitterPlacementGenerator::GetTileSeed(int32 Seed, int32 TileX, int32 TileY)
+{
+	using namespace LitterPlacementGenerator;
+
+	uint32 Hash = MixBits(static_cast<uint32>(Seed));
+	Hash = MixBits(Hash ^ static_cast<uint32>(TileX) * 0x9E3779B1u);
+	Hash = MixBits(Hash ^ static_cast<uint32>(TileY) * 0x7FEB352Du);
+	return static_cast<int32>(Hash);
+}
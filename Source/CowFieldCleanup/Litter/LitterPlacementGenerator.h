@@ -0,0 +1,16 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Litter/LitterTypes.h"
+
+// Deterministic litter layout from FLitterFieldParams. The field is split into square tiles, each
+// drawing from its own FRandomStream seeded from the field seed and tile coordinates, so tiles are
+// generated in parallel and the output is bit-identical on every machine and core count.
+// Placement DefinitionIndex refers to Params.ItemWeights.
+struct COWFIELDCLEANUP_API FLitterPlacementGenerator
+{
+	static constexpr int32 MaxTiles = 1 << 20;
+
+	static void Generate(const FLitterFieldParams& Params, TArray<FLitterPlacement>& OutPlacements);
+	static int32 GetTileSeed(int32 Seed, int32 TileX, int32 TileY);
+};
@@ -0,0 +1,30 @@
+#include "Litter/LitterTypes.h"
+
+#include "Engine/NetSerialization.h"
+
+bool FLitterPlacement::NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess)
+{
+	uint32 PackedDefinitionIndex = static_cast<uint32>(FMath::Max(0, DefinitionIndex));
+	Ar.SerializeIntPacked(PackedDefinitionIndex);
+	DefinitionIndex = static_cast<int32>(FMath::Min<uint32>(PackedDefinitionIndex, MAX_int32));
+
+	FVector WideLocation(Location);
+	bOutSuccess = SerializePackedVector<10, 24>(WideLocation, Ar);
+	Location = FVector3f(WideLocation);
+
+	uint8 PackedYaw = Ar.IsSaving() ? FRotator::CompressAxisToByte(Yaw) : 0;
+	Ar << PackedYaw;
+	if (Ar.IsLoading())
+	{
+		Yaw = FRotator::DecompressAxisFromByte(PackedYaw);
+	}
+
+	bOutSuccess &= !Ar.IsError();
+	return true;
+}
+
+bool FLitterFieldParams::IsValid() const
+{
+	return BoundsMax.X > BoundsMin.X && BoundsMax.Y > BoundsMin.Y && Density > 0.0f && TileSize > 0.0f
+		&& ItemWeights.ContainsByPredicate([](const FLitterSpawnWeight& ItemWeight) { return ItemWeight.ItemDefinition && ItemWeight.Weight > 0.0f; });
+}
@@ -0,0 +1,79 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "LitterTypes.generated.h"
+
+class UItemDefinitionDataAsset;
+
+USTRUCT(BlueprintType)
+struct FLitterPlacement
+{
+	GENERATED_BODY()
+
+	// Index into the owning field's item definition palette.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	int32 DefinitionIndex = 0;
+
+	// Sent quantized to a tenth of a unit.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	FVector3f Location = FVector3f::ZeroVector;
+
+	// Sent as a byte.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	float Yaw = 0.0f;
+
+	bool NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess);
+};
+
+template<>
+struct TStructOpsTypeTraits<FLitterPlacement> : public TStructOpsTypeTraitsBase2<FLitterPlacement>
+{
+	enum
+	{
+		WithNetSerializer = true
+	};
+};
+
+USTRUCT(BlueprintType)
+struct FLitterSpawnWeight
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	TObjectPtr<UItemDefinitionDataAsset> ItemDefinition;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (ClampMin = "0.0"))
+	float Weight = 1.0f;
+};
+
+// Inputs to FLitterPlacementGenerator. Replicated as-is so every machine generates the same field.
+USTRUCT(BlueprintType)
+struct FLitterFieldParams
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	int32 Seed = 0;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	FVector2D BoundsMin = FVector2D::ZeroVector;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	FVector2D BoundsMax = FVector2D::ZeroVector;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	float GroundZ = 0.0f;
+
+	// Expected items per square meter.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (ClampMin = "0.0"))
+	float Density = 0.02f;
+
+	// Each tile draws from its own random stream, so changing this changes the layout.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (ClampMin = "100.0"))
+	float TileSize = 2500.0f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	TArray<FLitterSpawnWeight> ItemWeights;
+
+	bool IsValid() const;
+};
@@ -0,0 +1,119 @@
+#include "Replication/CowFieldCleanupReplicationGraph.h"
+
+#include "Engine/NetDriver.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+#include "Inventory/DroppedToolMarker.h"
+#include "Inventory/DroppedToolRegistrySubsystem.h"
+
+static TAutoConsoleVariable<bool> CVarCowFieldCleanupUseReplicationGraph(
+	TEXT("CowFieldCleanup.Net.UseReplicationGraph"),
+	true,
+	TEXT("Use UCowFieldCleanupReplicationGraph for the game net driver. Read when the net driver is created."));
+
+void UReplicationGraphNode_DroppedTools::NotifyAddNetworkActor(const FNewReplicatedActorInfo& ActorInfo)
+{
+}
+
+bool UReplicationGraphNode_DroppedTools::NotifyRemoveNetworkActor(const FNewReplicatedActorInfo& ActorInfo, bool bWarnIfNotFound)
+{
+	return true;
+}
+
+void UReplicationGraphNode_DroppedTools::GatherActorListsForConnection(const FConnectionGatherActorListParameters& Params)
+{
+	const UWorld* World = GraphGlobals.IsValid() ? GraphGlobals->World : nullptr;
+	const UDroppedToolRegistrySubsystem* ToolRegistry = World ? World->GetSubsystem<UDroppedToolRegistrySubsystem>() : nullptr;
+	if (!ToolRegistry || ToolRegistry->GetNumTools() == 0)
+	{
+		return;
+	}
+
+	GatheredMarkers.Reset();
+	for (const FNetViewer& Viewer : Params.Viewers)
+	{
+		ToolRegistry->ForEachMarkerInRadius(Viewer.ViewLocation, CullDistance, [this, &Params](ADroppedToolMarker& Marker, double DistanceSquared)
+		{
+			FConnectionReplicationActorInfo& ConnectionActorInfo = Params.ConnectionManager.ActorInfoMap.FindOrAdd(&Marker);
+			ConnectionActorInfo.ReplicationPeriodFrame = GetReplicationPeriodFrames(DistanceSquared);
+			GatheredMarkers.Add(&Marker);
+		});
+	}
+
+	if (GatheredMarkers.Num() > 0)
+	{
+		Params.OutGatheredReplicationLists.AddReplicationActorList(GatheredMarkers);
+	}
+}
+
+uint16 UReplicationGraphNode_DroppedTools::GetReplicationPeriodFrames(double DistanceSquared) const
+{
+	if (DistanceSquared <= FMath::Square(static_cast<double>(NearDistance)))
+	{
+		return NearPeriodFrames;
+	}
+
+	if (DistanceSquared <= FMath::Square(static_cast<double>(MediumDistance)))
+	{
+		return MediumPeriodFrames;
+	}
+
+	return FarPeriodFrames;
+}
+
+UReplicationDriver* UCowFieldCleanupReplicationGraph::CreateForNetDriver(UNetDriver* ForNetDriver, const FURL& URL, UWorld* World)
+{
+	if (!CVarCowFieldCleanupUseReplicationGraph.GetValueOnGameThread() || !ForNetDriver || ForNetDriver->NetDriverName != NAME_GameNetDriver)
+	{
+		return nullptr;
+	}
+
+	return NewObject<UCowFieldCleanupReplicationGraph>(GetTransientPackage());
+}
+
+void UCowFieldCleanupReplicationGraph::InitGlobalActorClassSettings()
+{
+	Super::InitGlobalActorClassSettings();
+
+	// The dropped tool node culls against the registry grid, so markers skip the graph's own distance cull.
+	FClassReplicationInfo MarkerInfo;
+	MarkerInfo.ReplicationPeriodFrame = 1;
+	MarkerInfo.SetCullDistanceSquared(0.0f);
+	GlobalActorReplicationInfoMap.SetClassInfo(ADroppedToolMarker::StaticClass(), MarkerInfo);
+}
+
+void UCowFieldCleanupReplicationGraph::InitGlobalGraphNodes()
+{
+	Super::InitGlobalGraphNodes();
+
+	DroppedToolNode = CreateNewNode<UReplicationGraphNode_DroppedTools>();
+	DroppedToolNode->CullDistance = DroppedToolCullDistance;
+	DroppedToolNode->NearDistance = DroppedToolNearDistance;
+	DroppedToolNode->MediumDistance = DroppedToolMediumDistance;
+	DroppedToolNode->NearPeriodFrames = static_cast<uint16>(FMath::Clamp(DroppedToolNearPeriodFrames, 1, MAX_uint16));
+	DroppedToolNode->MediumPeriodFrames = static_cast<uint16>(FMath::Clamp(DroppedToolMediumPeriodFrames, 1, MAX_uint16));
+	DroppedToolNode->FarPeriodFrames = static_cast<uint16>(FMath::Clamp(DroppedToolFarPeriodFrames, 1, MAX_uint16));
+	AddGlobalGraphNode(DroppedToolNode);
+}
+
+void UCowFieldCleanupReplicationGraph::RouteAddNetworkActorToNodes(const FNewReplicatedActorInfo& ActorInfo, FGlobalActorReplicationInfo& GlobalInfo)
+{
+	if (ActorInfo.Class->IsChildOf(ADroppedToolMarker::StaticClass()))
+	{
+		DroppedToolNode->NotifyAddNetworkActor(ActorInfo);
+		return;
+	}
+
+	Super::RouteAddNetworkActorToNodes(ActorInfo, GlobalInfo);
+}
+
+void UCowFieldCleanupReplicationGraph::RouteRemoveNetworkActorToNodes(const FNewReplicatedActorInfo& ActorInfo)
+{
+	if (ActorInfo.Class->IsChildOf(ADroppedToolMarker::StaticClass()))
+	{
+		DroppedToolNode->NotifyRemoveNetworkActor(ActorInfo);
+		return;
+	}
+
+	Super::RouteRemoveNetworkActorToNodes(ActorInfo);
+}
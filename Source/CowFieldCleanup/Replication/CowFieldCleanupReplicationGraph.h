@@ -0,0 +1,69 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "BasicReplicationGraph.h"
+#include "CowFieldCleanupReplicationGraph.generated.h"
+
+class UNetDriver;
+class UReplicationDriver;
+
+// Gathers dropped tool markers near each viewer from the dropped tool registry grid and
+// lowers their per-connection replication rate with distance.
+UCLASS()
+class COWFIELDCLEANUP_API UReplicationGraphNode_DroppedTools : public UReplicationGraphNode
+{
+	GENERATED_BODY()
+
+public:
+	virtual void NotifyAddNetworkActor(const FNewReplicatedActorInfo& ActorInfo) override;
+	virtual bool NotifyRemoveNetworkActor(const FNewReplicatedActorInfo& ActorInfo, bool bWarnIfNotFound = true) override;
+	virtual void GatherActorListsForConnection(const FConnectionGatherActorListParameters& Params) override;
+
+	float CullDistance = 0.0f;
+	float NearDistance = 0.0f;
+	float MediumDistance = 0.0f;
+	uint16 NearPeriodFrames = 1;
+	uint16 MediumPeriodFrames = 1;
+	uint16 FarPeriodFrames = 1;
+
+private:
+	uint16 GetReplicationPeriodFrames(double DistanceSquared) const;
+
+	FActorRepListRefView GatheredMarkers;
+};
+
+UCLASS(Transient, Config = Engine)
+class COWFIELDCLEANUP_API UCowFieldCleanupReplicationGraph : public UBasicReplicationGraph
+{
+	GENERATED_BODY()
+
+public:
+	static UReplicationDriver* CreateForNetDriver(UNetDriver* ForNetDriver, const FURL& URL, UWorld* World);
+
+	virtual void InitGlobalActorClassSettings() override;
+	virtual void InitGlobalGraphNodes() override;
+	virtual void RouteAddNetworkActorToNodes(const FNewReplicatedActorInfo& ActorInfo, FGlobalActorReplicationInfo& GlobalInfo) override;
+	virtual void RouteRemoveNetworkActorToNodes(const FNewReplicatedActorInfo& ActorInfo) override;
+
+protected:
+	UPROPERTY(Config)
+	float DroppedToolCullDistance = 20000.0f;
+
+	UPROPERTY(Config)
+	float DroppedToolNearDistance = 2500.0f;
+
+	UPROPERTY(Config)
+	float DroppedToolMediumDistance = 8000.0f;
+
+	UPROPERTY(Config)
+	int32 DroppedToolNearPeriodFrames = 1;
+
+	UPROPERTY(Config)
+	int32 DroppedToolMediumPeriodFrames = 3;
+
+	UPROPERTY(Config)
+	int32 DroppedToolFarPeriodFrames = 8;
+
+	UPROPERTY()
+	TObjectPtr<UReplicationGraphNode_DroppedTools> DroppedToolNode;
+};
@@ -0,0 +1,25 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DeveloperSettings.h"
+#include "InventoryAssetSettings.generated.h"
+
+UCLASS(Config = Game, DefaultConfig, meta = (DisplayName = "Inventory Assets"))
+class COWFIELDCLEANUP_API UInventoryAssetSettings : public UDeveloperSettings
+{
+	GENERATED_BODY()
+
+public:
+	// Only scanned at runtime when the asset manager settings lack the type; keep both lists in sync.
+	UPROPERTY(Config, EditAnywhere, Category = "Asset Manager", meta = (ContentDir))
+	TArray<FDirectoryPath> ItemDefinitionDirectories;
+
+	UPROPERTY(Config, EditAnywhere, Category = "Asset Manager", meta = (ContentDir))
+	TArray<FDirectoryPath> BalanceDataDirectories;
+
+	UPROPERTY(Config, EditAnywhere, Category = "Preload")
+	TArray<FName> PreloadBundles = { TEXT("Field"), TEXT("UI") };
+
+	UPROPERTY(Config, EditAnywhere, Category = "Preload")
+	bool bPreloadOnMapLoad = true;
+};
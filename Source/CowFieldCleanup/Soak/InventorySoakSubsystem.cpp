@@ -0,0 +1,424 @@
+#include "Soak/InventorySoakSubsystem.h"
+
+#include "CowFieldCleanup.h"
+#include "DataAssets/ItemDefinitionDataAsset.h"
+#include "Dom/JsonObject.h"
+#include "Engine/Engine.h"
+#include "Engine/GameInstance.h"
+#include "Engine/NetConnection.h"
+#include "Engine/NetDriver.h"
+#include "Engine/World.h"
+#include "GameFramework/Pawn.h"
+#include "GameFramework/PlayerController.h"
+#include "GameFramework/PlayerState.h"
+#include "Inventory/DroppedToolRegistrySubsystem.h"
+#include "Inventory/InventoryComponent.h"
+#include "Inventory/InventoryStats.h"
+#include "Inventory/ItemDefinitionRegistry.h"
+#include "Misc/CommandLine.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Parse.h"
+#include "Misc/Paths.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+
+namespace InventorySoak
+{
+	constexpr int32 BotScriptLength = 10;
+	constexpr int32 MaxBotDroppedTools = 8;
+	constexpr float BotDropScatter = 400.0f;
+	constexpr float CowPushDistance = 300.0f;
+	constexpr double ConnectionSampleIntervalSeconds = 1.0;
+
+	// The inventory lives on whichever of pawn, player state or controller the game mode set it up on.
+	static UInventoryComponent* FindInventoryComponent(const APlayerController& PlayerController)
+	{
+		if (const APawn* Pawn = PlayerController.GetPawn())
+		{
+			if (UInventoryComponent* Inventory = Pawn->FindComponentByClass<UInventoryComponent>())
+			{
+				return Inventory;
+			}
+		}
+
+		if (const APlayerState* PlayerState = PlayerController.PlayerState)
+		{
+			if (UInventoryComponent* Inventory = PlayerState->FindComponentByClass<UInventoryComponent>())
+			{
+				return Inventory;
+			}
+		}
+
+		return PlayerController.FindComponentByClass<UInventoryComponent>();
+	}
+
+	static TSharedRef<FJsonObject> MakePercentiles(TArray<float> Samples)
+	{
+		Samples.Sort();
+		const auto Percentile = [&Samples](double Fraction)
+		{
+			return Samples.IsEmpty() ? 0.0f : Samples[FMath::Clamp(FMath::FloorToInt32(Fraction * (Samples.Num() - 1)), 0, Samples.Num() - 1)];
+		};
+
+		double Sum = 0.0;
+		for (const float Sample : Samples)
+		{
+			Sum += Sample;
+		}
+
+		TSharedRef<FJsonObject> Percentiles = MakeShared<FJsonObject>();
+		Percentiles->SetNumberField(TEXT("Samples"), Samples.Num());
+		Percentiles->SetNumberField(TEXT("Mean"), Samples.IsEmpty() ? 0.0 : Sum / Samples.Num());
+		Percentiles->SetNumberField(TEXT("P50"), Percentile(0.50));
+		Percentiles->SetNumberField(TEXT("P90"), Percentile(0.90));
+		Percentiles->SetNumberField(TEXT("P99"), Percentile(0.99));
+		Percentiles->SetNumberField(TEXT("Max"), Percentile(1.0));
+		return Percentiles;
+	}
+}
+
+bool UInventorySoakSubsystem::ShouldCreateSubsystem(UObject* Outer) const
+{
+#if UE_BUILD_SHIPPING
+	return false;
+#else
+	return FParse::Param(FCommandLine::Get(), TEXT("InventorySoak")) && Super::ShouldCreateSubsystem(Outer);
+#endif
+}
+
+void UInventorySoakSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	const TCHAR* CommandLine = FCommandLine::Get();
+	FParse::Value(CommandLine, TEXT("InventorySoakDuration="), DurationSeconds);
+	FParse::Value(CommandLine, TEXT("InventorySoakWarmup="), WarmupSeconds);
+	FParse::Value(CommandLine, TEXT("InventorySoakActionsPerSecond="), ActionsPerSecond);
+	FParse::Value(CommandLine, TEXT("InventorySoakCowMovesPerSecond="), CowMovesPerSecond);
+
+	InventoryStats::SetMeasureReplicatedBytes(true);
+	Random.Initialize(static_cast<int32>(FPlatformProcess::GetCurrentProcessId()));
+	StartSeconds = FPlatformTime::Seconds();
+	TickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateUObject(this, &UInventorySoakSubsystem::Tick));
+
+	UE_LOG(LogCowFieldCleanup, Display, TEXT("Inventory soak: %.0fs (%.0fs warm-up), %.1f bot actions/sec, %.1f cow moves/sec"),
+		DurationSeconds, WarmupSeconds, ActionsPerSecond, CowMovesPerSecond);
+}
+
+void UInventorySoakSubsystem::Deinitialize()
+{
+	FTSTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+	TickerHandle.Reset();
+
+	Super::Deinitialize();
+}
+
+bool UInventorySoakSubsystem::Tick(float DeltaTime)
+{
+	UWorld* World = GetGameInstance()->GetWorld();
+	if (bFinished || !World || !World->HasBegunPlay())
+	{
+		return true;
+	}
+
+	const double CurrentSeconds = FPlatformTime::Seconds();
+	const bool bIsClient = World->GetNetMode() == NM_Client;
+	if (bIsClient)
+	{
+		TickBot(*World, DeltaTime);
+	}
+	else
+	{
+		TickServer(*World, CurrentSeconds, DeltaTime);
+	}
+
+	if (CurrentSeconds - StartSeconds >= DurationSeconds)
+	{
+		bFinished = true;
+		if (!bIsClient)
+		{
+			WriteServerReport(CurrentSeconds);
+		}
+
+		UE_LOG(LogCowFieldCleanup, Display, TEXT("Inventory soak finished after %.0fs, exiting"), CurrentSeconds - StartSeconds);
+		FPlatformMisc::RequestExit(false);
+	}
+
+	return true;
+}
+
+void UInventorySoakSubsystem::TickServer(UWorld& World, double CurrentSeconds, float DeltaTime)
+{
+	MoveToolsLikeCows(World, DeltaTime);
+
+	if (!bMeasuring)
+	{
+		if (CurrentSeconds - StartSeconds < WarmupSeconds)
+		{
+			return;
+		}
+
+		bMeasuring = true;
+		MeasureStartSeconds = CurrentSeconds;
+		MeasureStartTotals = InventoryStats::GetTotals();
+		NextConnectionSampleSeconds = CurrentSeconds;
+
+		const int32 ExpectedFrames = FMath::CeilToInt32(FMath::Max(DurationSeconds - WarmupSeconds, 0.0) * 120.0);
+		FrameTimesMs.Reserve(ExpectedFrames);
+		GameThreadTimesMs.Reserve(ExpectedFrames);
+	}
+
+	FrameTimesMs.Add(DeltaTime * 1000.0f);
+	GameThreadTimesMs.Add(static_cast<float>(FPlatformTime::ToMilliseconds(GGameThreadTime)));
+
+	if (CurrentSeconds >= NextConnectionSampleSeconds)
+	{
+		SampleConnections(World, CurrentSeconds);
+		NextConnectionSampleSeconds = CurrentSeconds + InventorySoak::ConnectionSampleIntervalSeconds;
+	}
+}
+
+void UInventorySoakSubsystem::MoveToolsLikeCows(UWorld& World, float DeltaTime)
+{
+	UDroppedToolRegistrySubsystem* ToolRegistry = World.GetSubsystem<UDroppedToolRegistrySubsystem>();
+	if (!ToolRegistry || ToolRegistry->GetNumTools() == 0)
+	{
+		CowMoveAccumulator = 0.0f;
+		return;
+	}
+
+	CowMoveAccumulator = FMath::Min(CowMoveAccumulator + DeltaTime * CowMovesPerSecond, CowMovesPerSecond);
+	const int32 NumMoves = FMath::FloorToInt32(CowMoveAccumulator);
+	if (NumMoves <= 0)
+	{
+		return;
+	}
+	CowMoveAccumulator -= NumMoves;
+
+	ToolIdScratch.Reset();
+	ToolRegistry->ForEachTool([this](const FTrackedTool& TrackedTool)
+	{
+		if (TrackedTool.bIsDropped)
+		{
+			ToolIdScratch.Add(TrackedTool.ToolId);
+		}
+	});
+	if (ToolIdScratch.IsEmpty())
+	{
+		return;
+	}
+
+	for (int32 MoveIndex = 0; MoveIndex < NumMoves; ++MoveIndex)
+	{
+		const FGuid& ToolId = ToolIdScratch[Random.RandRange(0, ToolIdScratch.Num() - 1)];
+		// Only the dropping player's inventory may move a tool, so push it through that component.
+		const FTrackedTool* TrackedTool = ToolRegistry->FindTool(ToolId);
+		UInventoryComponent* OwningInventory = ToolRegistry->FindReplicatingComponent(ToolId);
+		if (TrackedTool && OwningInventory)
+		{
+			const FVector Push(Random.FRandRange(-InventorySoak::CowPushDistance, InventorySoak::CowPushDistance),
+				Random.FRandRange(-InventorySoak::CowPushDistance, InventorySoak::CowPushDistance), 0.0);
+			OwningInventory->UpdateDroppedToolLocation(ToolId, TrackedTool->WorldLocation + Push);
+		}
+	}
+}
+
+void UInventorySoakSubsystem::SampleConnections(UWorld& World, double CurrentSeconds)
+{
+	const UNetDriver* NetDriver = World.GetNetDriver();
+	if (!NetDriver)
+	{
+		return;
+	}
+
+	for (UNetConnection* Connection : NetDriver->ClientConnections)
+	{
+		if (!Connection || Connection->GetConnectionState() != USOCK_Open)
+		{
+			continue;
+		}
+
+		int32 PlayerId = INDEX_NONE;
+		uint64 InventoryBytes = 0;
+		if (const APlayerController* PlayerController = Connection->PlayerController)
+		{
+			PlayerId = PlayerController->PlayerState ? PlayerController->PlayerState->GetPlayerId() : INDEX_NONE;
+			if (const UInventoryComponent* Inventory = InventorySoak::FindInventoryComponent(*PlayerController))
+			{
+				InventoryBytes = Inventory->GetEstimatedReplicatedBytes();
+			}
+		}
+
+		FConnectionSample& Sample = ConnectionSamples.FindOrAdd(Connection);
+		if (Sample.NumSamples == 0)
+		{
+			Sample.Connection = Connection;
+			Sample.RemoteAddress = Connection->LowLevelGetRemoteAddress(true);
+			Sample.FirstInventoryBytes = InventoryBytes;
+			Sample.FirstSampleSeconds = CurrentSeconds;
+		}
+
+		Sample.PlayerId = PlayerId;
+		Sample.LastInventoryBytes = FMath::Max(InventoryBytes, Sample.FirstInventoryBytes);
+		Sample.LastSampleSeconds = CurrentSeconds;
+		Sample.InBytesPerSecondSum += Connection->InBytesPerSecond;
+		Sample.OutBytesPerSecondSum += Connection->OutBytesPerSecond;
+		++Sample.NumSamples;
+	}
+}
+
+void UInventorySoakSubsystem::WriteServerReport(double CurrentSeconds)
+{
+	const double MeasuredSeconds = bMeasuring ? CurrentSeconds - MeasureStartSeconds : 0.0;
+	const double SafeSeconds = FMath::Max(MeasuredSeconds, UE_SMALL_NUMBER);
+	const InventoryStats::FTotals EndTotals = InventoryStats::GetTotals();
+	const double RpcsReceivedPerSecond = (EndTotals.ReliableRpcsReceived - MeasureStartTotals.ReliableRpcsReceived) / SafeSeconds;
+	const double RpcsRejectedPerSecond = (EndTotals.RpcsRejected - MeasureStartTotals.RpcsRejected) / SafeSeconds;
+	const double ReplicatedBytesPerSecond = (EndTotals.ReplicatedBytes - MeasureStartTotals.ReplicatedBytes) / SafeSeconds;
+
+	const TSharedRef<FJsonObject> FrameTimes = InventorySoak::MakePercentiles(FrameTimesMs);
+	const TSharedRef<FJsonObject> GameThreadTimes = InventorySoak::MakePercentiles(GameThreadTimesMs);
+
+	TSharedRef<FJsonObject> Report = MakeShared<FJsonObject>();
+	Report->SetNumberField(TEXT("MeasuredSeconds"), MeasuredSeconds);
+	Report->SetNumberField(TEXT("Connections"), ConnectionSamples.Num());
+	Report->SetObjectField(TEXT("FrameTimeMs"), FrameTimes);
+	Report->SetObjectField(TEXT("GameThreadTimeMs"), GameThreadTimes);
+	Report->SetNumberField(TEXT("InventoryRpcsReceivedPerSecond"), RpcsReceivedPerSecond);
+	Report->SetNumberField(TEXT("InventoryRpcsRejectedPerSecond"), RpcsRejectedPerSecond);
+	Report->SetNumberField(TEXT("EstimatedInventoryBytesPerSecond"), ReplicatedBytesPerSecond);
+
+	TArray<TSharedPtr<FJsonValue>> ConnectionReports;
+	for (const TPair<TObjectKey<UNetConnection>, FConnectionSample>& Pair : ConnectionSamples)
+	{
+		const FConnectionSample& Sample = Pair.Value;
+		const double SampleSeconds = FMath::Max(Sample.LastSampleSeconds - Sample.FirstSampleSeconds, UE_SMALL_NUMBER);
+		const double InventoryBytesPerSecond = (Sample.LastInventoryBytes - Sample.FirstInventoryBytes) / SampleSeconds;
+		const double InBytesPerSecond = static_cast<double>(Sample.InBytesPerSecondSum) / Sample.NumSamples;
+		const double OutBytesPerSecond = static_cast<double>(Sample.OutBytesPerSecondSum) / Sample.NumSamples;
+
+		TSharedRef<FJsonObject> ConnectionReport = MakeShared<FJsonObject>();
+		ConnectionReport->SetStringField(TEXT("RemoteAddress"), Sample.RemoteAddress);
+		ConnectionReport->SetNumberField(TEXT("PlayerId"), Sample.PlayerId);
+		ConnectionReport->SetNumberField(TEXT("EstimatedInventoryBytesPerSecond"), InventoryBytesPerSecond);
+		ConnectionReport->SetNumberField(TEXT("ConnectionInBytesPerSecond"), InBytesPerSecond);
+		ConnectionReport->SetNumberField(TEXT("ConnectionOutBytesPerSecond"), OutBytesPerSecond);
+		ConnectionReports.Add(MakeShared<FJsonValueObject>(ConnectionReport));
+
+		UE_LOG(LogCowFieldCleanup, Display, TEXT("Inventory soak: %s (player %d): ~%.0f inventory B/s (estimated), %.0f in B/s, %.0f out B/s"),
+			*Sample.RemoteAddress, Sample.PlayerId, InventoryBytesPerSecond, InBytesPerSecond, OutBytesPerSecond);
+	}
+	Report->SetArrayField(TEXT("PerConnection"), ConnectionReports);
+
+	UE_LOG(LogCowFieldCleanup, Display, TEXT("Inventory soak: %d connections over %.0fs, frame p50/p99 %.2f/%.2f ms, game thread p50/p99 %.2f/%.2f ms, %.1f RPCs/sec (%.1f rejected/sec)"),
+		ConnectionSamples.Num(), MeasuredSeconds,
+		FrameTimes->GetNumberField(TEXT("P50")), FrameTimes->GetNumberField(TEXT("P99")),
+		GameThreadTimes->GetNumberField(TEXT("P50")), GameThreadTimes->GetNumberField(TEXT("P99")),
+		RpcsReceivedPerSecond, RpcsRejectedPerSecond);
+
+	FString ReportText;
+	const TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&ReportText);
+	FJsonSerializer::Serialize(Report, Writer);
+
+	const FString ReportPath = FPaths::ProjectSavedDir() / TEXT("Soak") / FString::Printf(TEXT("InventorySoak-%s.json"), *FDateTime::Now().ToString());
+	if (FFileHelper::SaveStringToFile(ReportText, *ReportPath))
+	{
+		UE_LOG(LogCowFieldCleanup, Display, TEXT("Inventory soak report written to %s"), *ReportPath);
+	}
+	else
+	{
+		UE_LOG(LogCowFieldCleanup, Error, TEXT("Failed to write inventory soak report to %s"), *ReportPath);
+	}
+}
+
+void UInventorySoakSubsystem::TickBot(UWorld& World, float DeltaTime)
+{
+	if (BotItemDefinitions.IsEmpty())
+	{
+		const UItemDefinitionRegistry* DefinitionRegistry = GEngine->GetEngineSubsystem<UItemDefinitionRegistry>();
+		const int32 NumDefinitions = DefinitionRegistry ? DefinitionRegistry->GetNumDefinitions() : 0;
+		for (int32 NetIndex = 0; NetIndex < NumDefinitions; ++NetIndex)
+		{
+			if (UItemDefinitionDataAsset* Definition = UItemDefinitionRegistry::ResolveNetIndex(static_cast<uint16>(NetIndex)))
+			{
+				BotItemDefinitions.Add(Definition);
+			}
+		}
+
+		if (BotItemDefinitions.IsEmpty())
+		{
+			return;
+		}
+	}
+
+	const APlayerController* PlayerController = World.GetFirstPlayerController();
+	UInventoryComponent* Inventory = PlayerController ? InventorySoak::FindInventoryComponent(*PlayerController) : nullptr;
+	if (!Inventory)
+	{
+		if (PlayerController && PlayerController->GetPawn() && !bWarnedMissingInventory)
+		{
+			UE_LOG(LogCowFieldCleanup, Warning, TEXT("Inventory soak bot has a pawn but no inventory component; sending no traffic"));
+			bWarnedMissingInventory = true;
+		}
+		return;
+	}
+
+	const FVector Location = PlayerController->GetPawn() ? PlayerController->GetPawn()->GetActorLocation() : FVector::ZeroVector;
+
+	// Capped at one second of actions so a hitch does not turn into a burst the rate limiter rejects.
+	BotActionAccumulator = FMath::Min(BotActionAccumulator + DeltaTime * ActionsPerSecond, ActionsPerSecond);
+	while (BotActionAccumulator >= 1.0f)
+	{
+		BotActionAccumulator -= 1.0f;
+		RunBotAction(*Inventory, Location);
+	}
+}
+
+void UInventorySoakSubsystem::RunBotAction(UInventoryComponent& Inventory, const FVector& Location)
+{
+	UItemDefinitionDataAsset* Definition = BotItemDefinitions[Random.RandRange(0, BotItemDefinitions.Num() - 1)];
+
+	// Fixed script per ten actions: five pickups, a deposit, two tool drops or recoveries and two locator pings.
+	const int32 Step = BotActionIndex++ % InventorySoak::BotScriptLength;
+	if (Step < 5)
+	{
+		Inventory.RequestAddBagItem(Definition, 1);
+	}
+	else if (Step == 5)
+	{
+		const TArray<FBagItemEntry>& BagEntries = Inventory.GetBagEntries();
+		if (!BagEntries.IsEmpty())
+		{
+			Inventory.RequestRemoveBagItem(BagEntries[0].ItemDefinition, BagEntries[0].Quantity);
+		}
+	}
+	else if (Step < 8)
+	{
+		if (BotDroppedToolIds.Num() < InventorySoak::MaxBotDroppedTools)
+		{
+			const FGuid ToolId = FGuid::NewGuid();
+			const FVector DropOffset(Random.FRandRange(-InventorySoak::BotDropScatter, InventorySoak::BotDropScatter),
+				Random.FRandRange(-InventorySoak::BotDropScatter, InventorySoak::BotDropScatter), 0.0);
+			Inventory.RequestAddToolToSlot(Definition, ToolId, 0);
+			Inventory.RequestRemoveToolFromSlot(0);
+			Inventory.RegisterOwnDroppedTool(ToolId, Location + DropOffset);
+			BotDroppedToolIds.Add(ToolId);
+		}
+		else
+		{
+			Inventory.RemoveDroppedTool(BotDroppedToolIds[0]);
+			BotDroppedToolIds.RemoveAt(0);
+		}
+	}
+	else if (Step == 8)
+	{
+		if (!BotDroppedToolIds.IsEmpty())
+		{
+			Inventory.RequestLocateTool(BotDroppedToolIds[Random.RandRange(0, BotDroppedToolIds.Num() - 1)]);
+		}
+	}
+	else
+	{
+		Inventory.RequestLocateAllMyTools(4);
+	}
+}
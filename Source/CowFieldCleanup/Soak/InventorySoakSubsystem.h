@@ -0,0 +1,85 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Ticker.h"
+#include "Inventory/InventoryStats.h"
+#include "Subsystems/GameInstanceSubsystem.h"
+#include "UObject/ObjectKey.h"
+#include "InventorySoakSubsystem.generated.h"
+
+class UInventoryComponent;
+class UItemDefinitionDataAsset;
+class UNetConnection;
+class UWorld;
+
+// Headless inventory soak harness, enabled with -InventorySoak. Bot clients drive scripted inventory traffic
+// (pickups, deposits, tool drops, locator pings); the server pushes dropped tools around as cows would and,
+// after the warm-up, records frame times, inventory RPC rates, per-connection bandwidth and the inventory's own
+// replicated-byte estimate. When -InventorySoakDuration elapses the server writes Saved/Soak/InventorySoak-<time>.json
+// and every process exits.
+// Other options: -InventorySoakWarmup=, -InventorySoakActionsPerSecond=, -InventorySoakCowMovesPerSecond=.
+UCLASS()
+class COWFIELDCLEANUP_API UInventorySoakSubsystem : public UGameInstanceSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+
+private:
+	struct FConnectionSample
+	{
+		TWeakObjectPtr<UNetConnection> Connection;
+		FString RemoteAddress;
+		int32 PlayerId = INDEX_NONE;
+		uint64 FirstInventoryBytes = 0;
+		uint64 LastInventoryBytes = 0;
+		double FirstSampleSeconds = 0.0;
+		double LastSampleSeconds = 0.0;
+		int64 InBytesPerSecondSum = 0;
+		int64 OutBytesPerSecondSum = 0;
+		int32 NumSamples = 0;
+	};
+
+	bool Tick(float DeltaTime);
+
+	void TickServer(UWorld& World, double CurrentSeconds, float DeltaTime);
+	void MoveToolsLikeCows(UWorld& World, float DeltaTime);
+	void SampleConnections(UWorld& World, double CurrentSeconds);
+	void WriteServerReport(double CurrentSeconds);
+
+	void TickBot(UWorld& World, float DeltaTime);
+	void RunBotAction(UInventoryComponent& Inventory, const FVector& Location);
+
+	FTSTicker::FDelegateHandle TickerHandle;
+	FRandomStream Random;
+
+	double StartSeconds = 0.0;
+	double DurationSeconds = 300.0;
+	double WarmupSeconds = 10.0;
+	float ActionsPerSecond = 10.0f;
+	float CowMovesPerSecond = 20.0f;
+	bool bFinished = false;
+
+	// Server measurement window, from the end of the warm-up.
+	bool bMeasuring = false;
+	double MeasureStartSeconds = 0.0;
+	double NextConnectionSampleSeconds = 0.0;
+	InventoryStats::FTotals MeasureStartTotals;
+	TArray<float> FrameTimesMs;
+	TArray<float> GameThreadTimesMs;
+	TMap<TObjectKey<UNetConnection>, FConnectionSample> ConnectionSamples;
+	TArray<FGuid> ToolIdScratch;
+	float CowMoveAccumulator = 0.0f;
+
+	// Bot state.
+	UPROPERTY(Transient)
+	TArray<TObjectPtr<UItemDefinitionDataAsset>> BotItemDefinitions;
+
+	TArray<FGuid> BotDroppedToolIds;
+	float BotActionAccumulator = 0.0f;
+	int32 BotActionIndex = 0;
+	bool bWarnedMissingInventory = false;
+};
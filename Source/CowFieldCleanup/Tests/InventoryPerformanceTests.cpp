@@ -0,0 +1,1065 @@
+#include "CoreMinimal.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "AI/DroppedToolQuerySubsystem.h"
+#include "Curves/CurveFloat.h"
+#include "DataAssets/InventoryBalanceDataAsset.h"
+#include "DataAssets/ItemDefinitionDataAsset.h"
+#include "Engine/DemoNetConnection.h"
+#include "Engine/DemoNetDriver.h"
+#include "Engine/Engine.h"
+#include "Engine/NetSerialization.h"
+#include "Engine/PackageMapClient.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+#include "GameFramework/Pawn.h"
+#include "GameFramework/PlayerController.h"
+#include "GameFramework/PlayerState.h"
+#include "HAL/IConsoleManager.h"
+#include "Inventory/DroppedToolRegistrySubsystem.h"
+#include "Inventory/InventoryComponent.h"
+#include "Inventory/InventoryRpcRateLimitSubsystem.h"
+#include "Inventory/ItemDefinitionRegistry.h"
+#include "Litter/LitterField.h"
+#include "Litter/LitterPlacementGenerator.h"
+#include "Misc/AutomationTest.h"
+#include "Net/RepLayout.h"
+#include "UObject/StrongObjectPtr.h"
+
+// Headless inventory benchmarks. Run with:
+//   UnrealEditor-Cmd <Project> -nullrhi -unattended -ExecCmds="Automation RunTests CowFieldCleanup.Inventory.Performance;Quit"
+
+// Test stand-in for an owning client's connection, pairing a non-authority inventory component with its server copy.
+// Batches the client flushes go to the server's RPC implementation, and the server's owner-only state comes back
+// through the same NetDeltaSerialize calls the net driver makes. Byte counts leave out packet, bunch and property
+// handle overhead. Tool slots are not carried; none of the scenarios that use this touch them.
+class FInventoryReplicationLoopback
+{
+public:
+	FInventoryReplicationLoopback(UInventoryComponent& InClient, UInventoryComponent& InServer, UNetDriver& InNetDriver, UPackageMap& InPackageMap)
+		: Client(InClient)
+		, Server(InServer)
+		, PackageMap(InPackageMap)
+		, NetSerializeCB(&InNetDriver)
+		, Writer(&InPackageMap, 1024 * 64 * 8)
+	{
+	}
+
+	UInventoryComponent& GetClient() const
+	{
+		return Client;
+	}
+
+	bool IsClientPredicting() const
+	{
+		return Client.IsPredicting();
+	}
+
+	// Flushes the client's queued ops and hands each batch it sent to the server; returns the RPC parameter bytes.
+	uint32 SendBatches()
+	{
+		// A standalone world absorbs the client's RPC, so the batches are cut from the queue the way FlushInventoryBatch cuts them.
+		SentOps.Reset();
+		SentOps.Append(Client.PendingBatchOps);
+		const uint32 FirstSequence = Client.LastSentBatchSequence;
+		Client.FlushInventoryBatch();
+
+		uint32 NumBytes = 0;
+		for (int32 FirstOp = 0; FirstOp < SentOps.Num(); FirstOp += UInventoryComponent::MaxInventoryBatchOps)
+		{
+			const int32 NumOps = FMath::Min(UInventoryComponent::MaxInventoryBatchOps, SentOps.Num() - FirstOp);
+			BatchOps.Reset();
+			BatchOps.Append(SentOps.GetData() + FirstOp, NumOps);
+			uint32 BatchSequence = FirstSequence + FirstOp + NumOps;
+
+			Writer.Reset();
+			uint16 NumBatchOps = static_cast<uint16>(NumOps);
+			Writer << NumBatchOps;
+			for (FInventoryBatchOp& Op : BatchOps)
+			{
+				bool bSuccess = false;
+				Op.NetSerialize(Writer, &PackageMap, bSuccess);
+			}
+			Writer << BatchSequence;
+			NumBytes += static_cast<uint32>(Writer.GetNumBytes());
+
+			Server.ServerApplyInventoryBatch_Implementation(BatchOps, BatchSequence);
+		}
+
+		return NumBytes;
+	}
+
+	// Sends what changed on the server since the last call, runs the client's rep notifies and lets it reconcile;
+	// returns the replicated bytes.
+	uint32 Replicate()
+	{
+		// A dormant owner's channel sends nothing until something wakes it.
+		if (Server.GetOwner()->NetDormancy > DORM_Awake)
+		{
+			return 0;
+		}
+
+		const uint32 BagEntriesBytes = ReplicateFastArray(Server.BagEntries, Client.BagEntries, BagEntriesState);
+		const uint32 TrackedToolsBytes = ReplicateFastArray(Server.TrackedTools, Client.TrackedTools, TrackedToolsState);
+		const uint32 BagWeightBytes = ReplicateProperty(Server.BagTotalWeight, Client.BagTotalWeight);
+		const uint32 AckBytes = ReplicateProperty(Server.LastProcessedBatchSequence, Client.LastProcessedBatchSequence);
+
+		// Rep notifies run once the whole update is in, as they do for a received bunch.
+		if (BagEntriesBytes > 0)
+		{
+			Client.OnRep_BagEntries();
+		}
+
+		if (TrackedToolsBytes > 0)
+		{
+			Client.OnRep_TrackedTools();
+		}
+
+		if (BagWeightBytes > 0)
+		{
+			Client.OnRep_BagTotalWeight();
+		}
+
+		if (AckBytes > 0)
+		{
+			Client.OnRep_LastProcessedBatchSequence();
+		}
+
+		// Stands in for the client's next tick.
+		if (Client.bReconcilePending)
+		{
+			Client.ReconcilePredictedOps();
+		}
+
+		return BagEntriesBytes + TrackedToolsBytes + BagWeightBytes + AckBytes;
+	}
+
+private:
+	template<typename ArrayType>
+	uint32 ReplicateFastArray(ArrayType& ServerArray, ArrayType& ClientArray, TSharedPtr<INetDeltaBaseState>& AckedState)
+	{
+		Writer.Reset();
+
+		TSharedPtr<INetDeltaBaseState> NewState;
+		FNetDeltaSerializeInfo WriteParms;
+		WriteParms.Writer = &Writer;
+		WriteParms.Map = &PackageMap;
+		WriteParms.Object = &Server;
+		WriteParms.NetSerializeCB = &NetSerializeCB;
+		WriteParms.OldState = AckedState.Get();
+		WriteParms.NewState = &NewState;
+		if (!ServerArray.NetDeltaSerialize(WriteParms))
+		{
+			return 0;
+		}
+
+		// Nothing is ever lost on the loopback, so each update is acked as soon as it is written.
+		AckedState = NewState;
+
+		FNetBitReader Reader(&PackageMap, Writer.GetData(), Writer.GetNumBits());
+		FNetDeltaSerializeInfo ReadParms;
+		ReadParms.Reader = &Reader;
+		ReadParms.Map = &PackageMap;
+		ReadParms.Object = &Client;
+		ReadParms.NetSerializeCB = &NetSerializeCB;
+		ClientArray.NetDeltaSerialize(ReadParms);
+
+		return static_cast<uint32>(Writer.GetNumBytes());
+	}
+
+	template<typename ValueType>
+	uint32 ReplicateProperty(ValueType ServerValue, ValueType& ClientValue)
+	{
+		if (ServerValue == ClientValue)
+		{
+			return 0;
+		}
+
+		Writer.Reset();
+		Writer << ServerValue;
+		ClientValue = ServerValue;
+		return static_cast<uint32>(Writer.GetNumBytes());
+	}
+
+	UInventoryComponent& Client;
+	UInventoryComponent& Server;
+	UPackageMap& PackageMap;
+	FNetSerializeCB NetSerializeCB;
+	FNetBitWriter Writer;
+	TSharedPtr<INetDeltaBaseState> BagEntriesState;
+	TSharedPtr<INetDeltaBaseState> TrackedToolsState;
+	TArray<FInventoryBatchOp> SentOps;
+	TArray<FInventoryBatchOp> BatchOps;
+};
+
+namespace InventoryPerformanceTests
+{
+	constexpr int32 NumSimulatedPlayers = 6;
+	constexpr int32 NumItemDefinitions = 32;
+
+	struct FScenarioBudget
+	{
+		const TCHAR* Name;
+		double MinOpsPerSecond;
+		double MaxAllocationsPerOp;
+		double MaxReplicatedBytesPerOp;
+	};
+
+	// Ops/sec and allocation budgets are floors with headroom, not CI measurements; tighten them when a scenario
+	// gets faster. Replicated bytes/op is sampled after the timed run: the op's RPC parameters as FPayloadMeter
+	// writes them, plus what every owning connection's FInventoryReplicationLoopback sends because of it.
+	static const FScenarioBudget ScenarioBudgets[] =
+	{
+		{ TEXT("BagAddRemove"), 500000.0, 0.05, 40.0 },
+		{ TEXT("BatchedBagAddRemove"), 20000.0, 32.0, 56.0 },
+		{ TEXT("LocateTool"), 100000.0, 0.5, 40.0 },
+		{ TEXT("DroppedToolChurn"), 250000.0, 0.05, 112.0 },
+		{ TEXT("BalanceCurveLookup"), 10000000.0, 0.0, 0.0 },
+		{ TEXT("SnapshotRoundTrip"), 2000.0, 1.0, 0.0 },
+		{ TEXT("LitterPickup"), 200000.0, 0.05, 48.0 },
+		{ TEXT("LitterGeneration"), 100.0, 4.0, 0.0 },
+		{ TEXT("DroppedToolQuery"), 500.0, 0.0, 0.0 },
+	};
+
+	static const FScenarioBudget& FindBudget(const TCHAR* ScenarioName)
+	{
+		for (const FScenarioBudget& Budget : ScenarioBudgets)
+		{
+			if (FCString::Strcmp(Budget.Name, ScenarioName) == 0)
+			{
+				return Budget;
+			}
+		}
+
+		checkNoEntry();
+		return ScenarioBudgets[0];
+	}
+
+	class FCountingMalloc final : public FMalloc
+	{
+	public:
+		explicit FCountingMalloc(FMalloc* InInnerMalloc)
+			: InnerMalloc(InInnerMalloc)
+		{
+		}
+
+		virtual void* Malloc(SIZE_T Count, uint32 Alignment) override
+		{
+			CountAllocation();
+			return InnerMalloc->Malloc(Count, Alignment);
+		}
+
+		virtual void* Realloc(void* Original, SIZE_T Count, uint32 Alignment) override
+		{
+			CountAllocation();
+			return InnerMalloc->Realloc(Original, Count, Alignment);
+		}
+
+		virtual void Free(void* Original) override
+		{
+			InnerMalloc->Free(Original);
+		}
+
+		virtual bool GetAllocationSize(void* Original, SIZE_T& SizeOut) override
+		{
+			return InnerMalloc->GetAllocationSize(Original, SizeOut);
+		}
+
+		virtual SIZE_T QuantizeSize(SIZE_T Count, uint32 Alignment) override
+		{
+			return InnerMalloc->QuantizeSize(Count, Alignment);
+		}
+
+		virtual void Trim(bool bTrimThreadCaches) override
+		{
+			InnerMalloc->Trim(bTrimThreadCaches);
+		}
+
+		virtual bool IsInternallyThreadSafe() const override
+		{
+			return InnerMalloc->IsInternallyThreadSafe();
+		}
+
+		virtual const TCHAR* GetDescriptiveName() override
+		{
+			return TEXT("InventoryPerformanceCountingMalloc");
+		}
+
+		uint64 GetNumAllocations() const
+		{
+			return NumAllocations.load(std::memory_order_relaxed);
+		}
+
+	private:
+		void CountAllocation()
+		{
+			if (IsInGameThread())
+			{
+				NumAllocations.fetch_add(1, std::memory_order_relaxed);
+			}
+		}
+
+		FMalloc* InnerMalloc;
+		std::atomic<uint64> NumAllocations{ 0 };
+	};
+
+	class FScopedAllocationCounter
+	{
+	public:
+		FScopedAllocationCounter()
+			: PreviousMalloc(GMalloc)
+			, CountingMalloc(GMalloc)
+		{
+			GMalloc = &CountingMalloc;
+		}
+
+		~FScopedAllocationCounter()
+		{
+			GMalloc = PreviousMalloc;
+		}
+
+		uint64 GetNumAllocations() const
+		{
+			return CountingMalloc.GetNumAllocations();
+		}
+
+	private:
+		FMalloc* PreviousMalloc;
+		FCountingMalloc CountingMalloc;
+	};
+
+	struct FScenarioResult
+	{
+		int64 NumOps = 0;
+		double Seconds = 0.0;
+		uint64 NumAllocations = 0;
+		double ReplicatedBytesPerOp = 0.0;
+	};
+
+	class FSimulatedMatch
+	{
+	public:
+		FSimulatedMatch()
+		{
+			World = UWorld::CreateWorld(EWorldType::Game, false, TEXT("InventoryPerformanceWorld"));
+			FWorldContext& WorldContext = GEngine->CreateNewWorldContext(EWorldType::Game);
+			WorldContext.SetCurrentWorld(World);
+			World->InitializeActorsForPlay(FURL());
+			World->BeginPlay();
+
+			BalanceData = NewObject<UInventoryBalanceDataAsset>(GetTransientPackage());
+			BalanceData->MaxBagWeight = 0.0f;
+			BalanceData->NearDistance = 1000.0f;
+			BalanceData->MediumDistance = 5000.0f;
+			BalanceData->LocateCooldownSeconds = 0.0f;
+			BalanceData->MovementSpeedByWeight = MakeCurve(1.0f, 0.4f);
+			BalanceData->StaminaDrainMultiplierByWeight = MakeCurve(1.0f, 2.5f);
+			BalanceData->RebuildCompiledProfile();
+
+			for (int32 DefinitionIndex = 0; DefinitionIndex < NumItemDefinitions; ++DefinitionIndex)
+			{
+				UItemDefinitionDataAsset* Definition = NewObject<UItemDefinitionDataAsset>(GetTransientPackage());
+				Definition->ItemId = *FString::Printf(TEXT("PerfLitter_%02d"), DefinitionIndex);
+				Definition->ItemWeight = 0.25f + DefinitionIndex * 0.05f;
+				Definition->AddToRoot();
+				UItemDefinitionRegistry::RegisterRuntimeDefinition(Definition);
+				ItemDefinitions.Add(Definition);
+			}
+			BalanceData->AddToRoot();
+
+			// Never initialized or ticked; it only lends the loopbacks its struct rep layouts and GUID cache.
+			NetDriver = NewObject<UDemoNetDriver>(GetTransientPackage());
+			NetDriver->AddToRoot();
+			PackageMap = NewObject<UPackageMap>(GetTransientPackage());
+			PackageMap->AddToRoot();
+
+			for (int32 PlayerIndex = 0; PlayerIndex < NumSimulatedPlayers; ++PlayerIndex)
+			{
+				UInventoryComponent* Inventory = SpawnPlayerInventory(PlayerIndex, ROLE_Authority);
+				UInventoryComponent* ClientInventory = SpawnPlayerInventory(PlayerIndex, ROLE_AutonomousProxy);
+				Inventories.Add(Inventory);
+				Loopbacks.Add(MakeUnique<FInventoryReplicationLoopback>(*ClientInventory, *Inventory, *NetDriver, *PackageMap));
+			}
+		}
+
+		~FSimulatedMatch()
+		{
+			Loopbacks.Reset();
+
+			for (UItemDefinitionDataAsset* Definition : ItemDefinitions)
+			{
+				Definition->RemoveFromRoot();
+			}
+			BalanceData->RemoveFromRoot();
+			PackageMap->RemoveFromRoot();
+			NetDriver->RemoveFromRoot();
+
+			GEngine->DestroyWorldContext(World);
+			World->DestroyWorld(false);
+		}
+
+		// Sends every owning client what changed on the server; returns the replicated bytes.
+		uint32 ReplicateAll()
+		{
+			uint32 NumBytes = 0;
+			for (const TUniquePtr<FInventoryReplicationLoopback>& Loopback : Loopbacks)
+			{
+				NumBytes += Loopback->Replicate();
+			}
+			return NumBytes;
+		}
+
+		UWorld* World = nullptr;
+		UInventoryBalanceDataAsset* BalanceData = nullptr;
+		UDemoNetDriver* NetDriver = nullptr;
+		UPackageMap* PackageMap = nullptr;
+		TArray<UItemDefinitionDataAsset*> ItemDefinitions;
+		// Server-side inventories, one per player, with the player ids 1 to NumSimulatedPlayers.
+		TArray<UInventoryComponent*> Inventories;
+		// Each player's owning connection, pairing Inventories[PlayerIndex] with that player's client copy.
+		TArray<TUniquePtr<FInventoryReplicationLoopback>> Loopbacks;
+
+	private:
+		UInventoryComponent* SpawnPlayerInventory(int32 PlayerIndex, ENetRole Role)
+		{
+			// The client copy gets its own player state, as it would hold its own replicated one.
+			APlayerState* PlayerState = World->SpawnActor<APlayerState>();
+			PlayerState->SetPlayerId(PlayerIndex + 1);
+
+			APawn* PlayerPawn = World->SpawnActor<APawn>();
+			PlayerPawn->SetPlayerState(PlayerState);
+			PlayerPawn->SetRole(Role);
+
+			UInventoryComponent* Inventory = NewObject<UInventoryComponent>(PlayerPawn);
+			Inventory->SetBalanceData(BalanceData);
+			Inventory->RegisterComponent();
+			return Inventory;
+		}
+
+		static UCurveFloat* MakeCurve(float StartValue, float EndValue)
+		{
+			UCurveFloat* Curve = NewObject<UCurveFloat>(GetTransientPackage());
+			Curve->FloatCurve.AddKey(0.0f, StartValue);
+			Curve->FloatCurve.AddKey(50.0f, FMath::Lerp(StartValue, EndValue, 0.3f));
+			Curve->FloatCurve.AddKey(100.0f, EndValue);
+			return Curve;
+		}
+	};
+
+	template<typename FuncType>
+	static FScenarioResult RunScenario(int64 NumOps, FuncType&& Body)
+	{
+		FScenarioResult Result;
+		Result.NumOps = NumOps;
+
+		FScopedAllocationCounter AllocationCounter;
+		const double StartSeconds = FPlatformTime::Seconds();
+		for (int64 OpIndex = 0; OpIndex < NumOps; ++OpIndex)
+		{
+			Body(OpIndex);
+		}
+		Result.Seconds = FPlatformTime::Seconds() - StartSeconds;
+		Result.NumAllocations = AllocationCounter.GetNumAllocations();
+		return Result;
+	}
+
+	// Writes RPC parameters the way they go on the wire: NetSerialize for structs that have one, the archive operator
+	// otherwise, and object references as the NetGUID the server's GUID cache gives them.
+	class FPayloadMeter
+	{
+	public:
+		explicit FPayloadMeter(FSimulatedMatch& InMatch)
+			: Match(InMatch)
+			, Writer(InMatch.PackageMap, 1024 * 8)
+		{
+		}
+
+		template<typename ValueType>
+		FPayloadMeter& Add(const ValueType& Value)
+		{
+			ValueType Copy = Value;
+			if constexpr (std::is_arithmetic_v<ValueType>)
+			{
+				Writer << Copy;
+			}
+			else if constexpr (TStructOpsTypeTraits<ValueType>::WithNetSerializer)
+			{
+				bool bSuccess = false;
+				Copy.NetSerialize(Writer, nullptr, bSuccess);
+			}
+			else
+			{
+				Writer << Copy;
+			}
+			return *this;
+		}
+
+		// An actor that already has a channel is referenced by its NetGUID alone.
+		FPayloadMeter& AddObject(UObject* Object)
+		{
+			FNetGUIDCache& GuidCache = *Match.NetDriver->GuidCache;
+			FNetworkGUID NetGUID = GuidCache.GetNetGUID(Object);
+			if (!NetGUID.IsValid())
+			{
+				NetGUID = GuidCache.AssignNewNetGUID_Server(Object);
+			}
+
+			Writer << NetGUID;
+			return *this;
+		}
+
+		uint32 GetNumBytes() const
+		{
+			return static_cast<uint32>(Writer.GetNumBytes());
+		}
+
+	private:
+		FSimulatedMatch& Match;
+		FNetBitWriter Writer;
+	};
+
+	// Runs ops one at a time outside the timed loop and averages what each puts on the wire. Body runs one op and
+	// returns its RPC parameter bytes; every loopback is settled first so only the op's own changes are counted.
+	template<typename FuncType>
+	static double MeasureReplicatedBytesPerOp(FSimulatedMatch& Match, int64 NumOps, FuncType&& Body)
+	{
+		Match.ReplicateAll();
+
+		uint64 NumBytes = 0;
+		for (int64 OpIndex = 0; OpIndex < NumOps; ++OpIndex)
+		{
+			NumBytes += Body(OpIndex);
+			NumBytes += Match.ReplicateAll();
+		}
+		return NumOps > 0 ? static_cast<double>(NumBytes) / NumOps : 0.0;
+	}
+
+	constexpr int64 NumSampledOps = 64;
+
+	static bool ReportAndCheck(FAutomationTestBase& Test, const TCHAR* ScenarioName, const FScenarioResult& Result)
+	{
+		const FScenarioBudget& Budget = FindBudget(ScenarioName);
+		const double OpsPerSecond = Result.Seconds > 0.0 ? Result.NumOps / Result.Seconds : TNumericLimits<double>::Max();
+		const double AllocationsPerOp = Result.NumOps > 0 ? static_cast<double>(Result.NumAllocations) / Result.NumOps : 0.0;
+
+		Test.AddInfo(FString::Printf(TEXT("%s: %.0f ops/sec, %.4f allocations/op, %.1f replicated bytes/op (%lld ops in %.3f ms)"),
+			ScenarioName, OpsPerSecond, AllocationsPerOp, Result.ReplicatedBytesPerOp, Result.NumOps, Result.Seconds * 1000.0));
+
+		Test.TestTrue(FString::Printf(TEXT("%s ops/sec %.0f >= budget %.0f"), ScenarioName, OpsPerSecond, Budget.MinOpsPerSecond), OpsPerSecond >= Budget.MinOpsPerSecond);
+		Test.TestTrue(FString::Printf(TEXT("%s allocations/op %.4f <= budget %.4f"), ScenarioName, AllocationsPerOp, Budget.MaxAllocationsPerOp), AllocationsPerOp <= Budget.MaxAllocationsPerOp);
+		Test.TestTrue(FString::Printf(TEXT("%s replicated bytes/op %.1f <= budget %.1f"), ScenarioName, Result.ReplicatedBytesPerOp, Budget.MaxReplicatedBytesPerOp), Result.ReplicatedBytesPerOp <= Budget.MaxReplicatedBytesPerOp);
+		return !Test.HasAnyErrors();
+	}
+
+	static FGuid MakeToolId(int32 ToolIndex)
+	{
+		return FGuid(0xC0FFEE, 0, 0, static_cast<uint32>(ToolIndex + 1));
+	}
+
+	static FVector MakeToolLocation(int32 ToolIndex, int32 Step)
+	{
+		const int32 GridX = ToolIndex % 32;
+		const int32 GridY = ToolIndex / 32;
+		return FVector(GridX * 750.0 + (Step % 7) * 40.0, GridY * 750.0 + (Step % 5) * 40.0, 0.0);
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FInventoryBagAddRemovePerformanceTest, "CowFieldCleanup.Inventory.Performance.BagAddRemove",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+bool FInventoryBagAddRemovePerformanceTest::RunTest(const FString& Parameters)
+{
+	using namespace InventoryPerformanceTests;
+
+	FSimulatedMatch Match;
+	constexpr int64 NumOps = 10000;
+
+	// Server-side adds and removes, as the host applies them; BatchedBagAddRemove covers a remote owner's batches.
+	auto AddOrRemove = [&Match](int64 OpIndex)
+	{
+		UInventoryComponent* Inventory = Match.Inventories[OpIndex % NumSimulatedPlayers];
+		UItemDefinitionDataAsset* Definition = Match.ItemDefinitions[(OpIndex / NumSimulatedPlayers) % NumItemDefinitions];
+		if ((OpIndex / (NumSimulatedPlayers * NumItemDefinitions)) % 3 == 2)
+		{
+			Inventory->RequestRemoveBagItem(Definition, 1);
+		}
+		else
+		{
+			Inventory->RequestAddBagItem(Definition, 1);
+		}
+	};
+
+	FScenarioResult Result = RunScenario(NumOps, AddOrRemove);
+
+	// No RPC; the owner is sent the bag delta and the new weight.
+	Result.ReplicatedBytesPerOp = MeasureReplicatedBytesPerOp(Match, NumSampledOps, [&AddOrRemove](int64 OpIndex)
+	{
+		AddOrRemove(NumOps + OpIndex);
+		return 0u;
+	});
+
+	for (int32 PlayerIndex = 0; PlayerIndex < NumSimulatedPlayers; ++PlayerIndex)
+	{
+		TestEqual(FString::Printf(TEXT("Player %d's replicated bag matches the server's"), PlayerIndex + 1),
+			Match.Loopbacks[PlayerIndex]->GetClient().GetBagEntries().Num(), Match.Inventories[PlayerIndex]->GetBagEntries().Num());
+	}
+
+	return ReportAndCheck(*this, TEXT("BagAddRemove"), Result);
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FInventoryBatchedBagAddRemovePerformanceTest, "CowFieldCleanup.Inventory.Performance.BatchedBagAddRemove",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+bool FInventoryBatchedBagAddRemovePerformanceTest::RunTest(const FString& Parameters)
+{
+	using namespace InventoryPerformanceTests;
+
+	FSimulatedMatch Match;
+	constexpr int64 NumOps = 5000;
+
+	// One op is a remote owner's predicted add or remove: queued, flushed as a batch, applied by the server, and
+	// replicated back with the ack that reconciles the prediction.
+	auto BatchedAddOrRemove = [&Match](int64 OpIndex)
+	{
+		FInventoryReplicationLoopback& Loopback = *Match.Loopbacks[OpIndex % NumSimulatedPlayers];
+		UItemDefinitionDataAsset* Definition = Match.ItemDefinitions[(OpIndex / NumSimulatedPlayers) % NumItemDefinitions];
+		if ((OpIndex / (NumSimulatedPlayers * NumItemDefinitions)) % 3 == 2)
+		{
+			Loopback.GetClient().RequestRemoveBagItem(Definition, 1);
+		}
+		else
+		{
+			Loopback.GetClient().RequestAddBagItem(Definition, 1);
+		}
+
+		return Loopback.SendBatches() + Loopback.Replicate();
+	};
+
+	FScenarioResult Result = RunScenario(NumOps, BatchedAddOrRemove);
+	Result.ReplicatedBytesPerOp = MeasureReplicatedBytesPerOp(Match, NumSampledOps, [&BatchedAddOrRemove](int64 OpIndex)
+	{
+		return BatchedAddOrRemove(NumOps + OpIndex);
+	});
+
+	for (int32 PlayerIndex = 0; PlayerIndex < NumSimulatedPlayers; ++PlayerIndex)
+	{
+		const FInventoryReplicationLoopback& Loopback = *Match.Loopbacks[PlayerIndex];
+		const TArray<FBagItemEntry>& ClientBag = Loopback.GetClient().GetBagEntries();
+		const TArray<FBagItemEntry>& ServerBag = Match.Inventories[PlayerIndex]->GetBagEntries();
+
+		TestFalse(FString::Printf(TEXT("Player %d has no unacked predictions left"), PlayerIndex + 1), Loopback.IsClientPredicting());
+		TestEqual(FString::Printf(TEXT("Player %d's bag matches the server's"), PlayerIndex + 1), ClientBag.Num(), ServerBag.Num());
+		for (const FBagItemEntry& ServerEntry : ServerBag)
+		{
+			const FBagItemEntry* ClientEntry = ClientBag.FindByPredicate([&ServerEntry](const FBagItemEntry& Entry) { return Entry.ItemDefinition == ServerEntry.ItemDefinition; });
+			TestTrue(FString::Printf(TEXT("Player %d holds the server's quantity of %s"), PlayerIndex + 1, *GetNameSafe(ServerEntry.ItemDefinition)),
+				ClientEntry && ClientEntry->Quantity == ServerEntry.Quantity);
+		}
+	}
+
+	return ReportAndCheck(*this, TEXT("BatchedBagAddRemove"), Result);
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FInventoryLocateToolPerformanceTest, "CowFieldCleanup.Inventory.Performance.LocateTool",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+bool FInventoryLocateToolPerformanceTest::RunTest(const FString& Parameters)
+{
+	using namespace InventoryPerformanceTests;
+
+	FSimulatedMatch Match;
+	constexpr int32 NumTools = 1000;
+	for (int32 ToolIndex = 0; ToolIndex < NumTools; ++ToolIndex)
+	{
+		Match.Inventories[ToolIndex % NumSimulatedPlayers]->RegisterOwnDroppedTool(MakeToolId(ToolIndex), MakeToolLocation(ToolIndex, 0));
+	}
+
+	// Players can only locate their own tools, so each op is made by the tool's owner.
+	constexpr int64 NumOps = 20000;
+	auto Locate = [&Match](int64 OpIndex)
+	{
+		const int32 ToolIndex = static_cast<int32>((OpIndex * 7919) % NumTools);
+		Match.Inventories[ToolIndex % NumSimulatedPlayers]->RequestLocateTool(MakeToolId(ToolIndex));
+		return ToolIndex;
+	};
+
+	FScenarioResult Result = RunScenario(NumOps, Locate);
+
+	// The requested tool id in, and the locator result out, built from the registry record as the server builds it.
+	const UDroppedToolRegistrySubsystem* ToolRegistry = Match.World->GetSubsystem<UDroppedToolRegistrySubsystem>();
+	Result.ReplicatedBytesPerOp = MeasureReplicatedBytesPerOp(Match, NumSampledOps, [&Match, &Locate, ToolRegistry](int64 OpIndex)
+	{
+		const int32 ToolIndex = Locate(NumOps + OpIndex);
+		const FTrackedTool* TrackedTool = ToolRegistry->FindTool(MakeToolId(ToolIndex));
+		const FVector Offset = TrackedTool->WorldLocation - Match.Inventories[ToolIndex % NumSimulatedPlayers]->GetOwner()->GetActorLocation();
+
+		// The distance band is a fixed two bits, so its value does not change the size.
+		FToolLocatorResult LocatorResult;
+		LocatorResult.ToolId = TrackedTool->ToolId;
+		LocatorResult.DirectionYaw = FRotator::ClampAxis(FMath::RadiansToDegrees(FMath::Atan2(Offset.Y, Offset.X)));
+		LocatorResult.Distance = Offset.Size();
+		return FPayloadMeter(Match).Add(LocatorResult.ToolId).Add(LocatorResult).GetNumBytes();
+	});
+
+	const FTrackedTool* FirstTool = ToolRegistry->FindTool(MakeToolId(0));
+	TestTrue(TEXT("Tool 0 is owned by player 1, who registered it"), FirstTool && FirstTool->OwnerPlayerId == 1);
+
+	return ReportAndCheck(*this, TEXT("LocateTool"), Result);
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FInventoryDroppedToolChurnPerformanceTest, "CowFieldCleanup.Inventory.Performance.DroppedToolChurn",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+bool FInventoryDroppedToolChurnPerformanceTest::RunTest(const FString& Parameters)
+{
+	using namespace InventoryPerformanceTests;
+
+	FSimulatedMatch Match;
+	constexpr int32 NumTools = 1000;
+	for (int32 ToolIndex = 0; ToolIndex < NumTools; ++ToolIndex)
+	{
+		Match.Inventories[ToolIndex % NumSimulatedPlayers]->RegisterOwnDroppedTool(MakeToolId(ToolIndex), MakeToolLocation(ToolIndex, 0));
+	}
+
+	constexpr int64 NumOps = 50000;
+	auto MoveTool = [&Match](int64 OpIndex)
+	{
+		const int32 ToolIndex = static_cast<int32>(OpIndex % NumTools);
+		const int32 Step = static_cast<int32>(OpIndex / NumTools) + 1;
+		const FVector Location = MakeToolLocation(ToolIndex, Step);
+		Match.Inventories[ToolIndex % NumSimulatedPlayers]->UpdateDroppedToolLocation(MakeToolId(ToolIndex), Location);
+		return Location;
+	};
+
+	FScenarioResult Result = RunScenario(NumOps, MoveTool);
+
+	// The streamed location in, then the owner's tracked tool delta out.
+	Result.ReplicatedBytesPerOp = MeasureReplicatedBytesPerOp(Match, NumSampledOps, [&Match, &MoveTool](int64 OpIndex)
+	{
+		const FVector Location = MoveTool(NumOps + OpIndex);
+		const int32 ToolIndex = static_cast<int32>((NumOps + OpIndex) % NumTools);
+		return FPayloadMeter(Match).Add(MakeToolId(ToolIndex)).Add(FVector_NetQuantize10(Location)).GetNumBytes();
+	});
+
+	return ReportAndCheck(*this, TEXT("DroppedToolChurn"), Result);
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FInventoryBalanceCurvePerformanceTest, "CowFieldCleanup.Inventory.Performance.BalanceCurveLookup",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+bool FInventoryBalanceCurvePerformanceTest::RunTest(const FString& Parameters)
+{
+	using namespace InventoryPerformanceTests;
+
+	FSimulatedMatch Match;
+	const TSharedRef<const FInventoryBalanceProfile> Profile = Match.BalanceData->GetCompiledProfile();
+
+	float Accumulator = 0.0f;
+	constexpr int64 NumOps = 2000000;
+	FScenarioResult Result = RunScenario(NumOps, [&Profile, &Accumulator](int64 OpIndex)
+	{
+		const float BagWeight = static_cast<float>(OpIndex % 1000) * 0.1f;
+		Accumulator += Profile->GetMovementSpeedMultiplier(BagWeight) + Profile->GetStaminaDrainMultiplier(BagWeight);
+	});
+
+	TestTrue(TEXT("Baked curves produce finite values"), FMath::IsFinite(Accumulator));
+	TestEqual(TEXT("Baked movement curve matches rich curve at the last key"),
+		Profile->GetMovementSpeedMultiplier(100.0f),
+		Match.BalanceData->MovementSpeedByWeight->GetFloatValue(100.0f),
+		KINDA_SMALL_NUMBER);
+
+	return ReportAndCheck(*this, TEXT("BalanceCurveLookup"), Result);
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FInventorySnapshotRoundTripPerformanceTest, "CowFieldCleanup.Inventory.Performance.SnapshotRoundTrip",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+bool FInventorySnapshotRoundTripPerformanceTest::RunTest(const FString& Parameters)
+{
+	using namespace InventoryPerformanceTests;
+
+	FSimulatedMatch Match;
+	constexpr int32 NumToolsPerPlayer = 8;
+	for (int32 PlayerIndex = 0; PlayerIndex < NumSimulatedPlayers; ++PlayerIndex)
+	{
+		UInventoryComponent* Inventory = Match.Inventories[PlayerIndex];
+		for (int32 SlotIndex = 0; SlotIndex < Inventory->GetToolSlots().Num(); ++SlotIndex)
+		{
+			Inventory->RequestAddToolToSlot(Match.ItemDefinitions[SlotIndex], MakeToolId(PlayerIndex * 100 + SlotIndex), SlotIndex);
+		}
+
+		for (UItemDefinitionDataAsset* Definition : Match.ItemDefinitions)
+		{
+			Inventory->RequestAddBagItem(Definition, 3);
+		}
+
+		for (int32 ToolIndex = 0; ToolIndex < NumToolsPerPlayer; ++ToolIndex)
+		{
+			const int32 GlobalToolIndex = PlayerIndex * NumToolsPerPlayer + ToolIndex;
+			Inventory->RegisterOwnDroppedTool(MakeToolId(1000 + GlobalToolIndex), MakeToolLocation(GlobalToolIndex, 0));
+		}
+	}
+
+	TArray<TArray<uint8>> Snapshots;
+	Snapshots.SetNum(NumSimulatedPlayers);
+	for (int32 PlayerIndex = 0; PlayerIndex < NumSimulatedPlayers; ++PlayerIndex)
+	{
+		Match.Inventories[PlayerIndex]->SaveSnapshot(Snapshots[PlayerIndex]);
+	}
+
+	const TArray<FBagItemEntry> ExpectedBagEntries = Match.Inventories[0]->GetBagEntries();
+	const TArray<FToolSlotEntry> ExpectedToolSlots = Match.Inventories[0]->GetToolSlots();
+	const float ExpectedBagWeight = Match.Inventories[0]->GetBagTotalWeight();
+
+	// One op is a full party: every inventory saved and loaded back.
+	constexpr int64 NumOps = 2000;
+	FScenarioResult Result = RunScenario(NumOps, [&Match, &Snapshots](int64 OpIndex)
+	{
+		for (int32 PlayerIndex = 0; PlayerIndex < NumSimulatedPlayers; ++PlayerIndex)
+		{
+			UInventoryComponent* Inventory = Match.Inventories[PlayerIndex];
+			Inventory->SaveSnapshot(Snapshots[PlayerIndex]);
+			Inventory->LoadSnapshot(Snapshots[PlayerIndex]);
+		}
+	});
+
+	TestEqual(TEXT("Bag entries survive the round trip"), Match.Inventories[0]->GetBagEntries().Num(), ExpectedBagEntries.Num());
+	TestEqual(TEXT("Bag weight survives the round trip"), Match.Inventories[0]->GetBagTotalWeight(), ExpectedBagWeight, KINDA_SMALL_NUMBER);
+	for (int32 SlotIndex = 0; SlotIndex < ExpectedToolSlots.Num(); ++SlotIndex)
+	{
+		const FToolSlotEntry& Slot = Match.Inventories[0]->GetToolSlots()[SlotIndex];
+		TestTrue(FString::Printf(TEXT("Tool slot %d survives the round trip"), SlotIndex),
+			Slot.ItemDefinition == ExpectedToolSlots[SlotIndex].ItemDefinition && Slot.ToolId == ExpectedToolSlots[SlotIndex].ToolId);
+	}
+
+	// Loading into another player's inventory stands in for arriving on a new map under a new player id.
+	const UDroppedToolRegistrySubsystem* ToolRegistry = Match.World->GetSubsystem<UDroppedToolRegistrySubsystem>();
+	Match.Inventories[1]->LoadSnapshot(Snapshots[0]);
+	const FTrackedTool* DroppedTool = ToolRegistry->FindTool(MakeToolId(1000));
+	TestTrue(TEXT("Dropped tools are not restored from a snapshot"), DroppedTool && DroppedTool->OwnerPlayerId == 1);
+
+	int32 PartySnapshotBytes = 0;
+	for (const TArray<uint8>& Snapshot : Snapshots)
+	{
+		PartySnapshotBytes += Snapshot.Num();
+	}
+	AddInfo(FString::Printf(TEXT("SnapshotRoundTrip: %d bytes for a %d-player party"), PartySnapshotBytes, NumSimulatedPlayers));
+
+	return ReportAndCheck(*this, TEXT("SnapshotRoundTrip"), Result);
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FInventoryLitterPickupPerformanceTest, "CowFieldCleanup.Inventory.Performance.LitterPickup",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+bool FInventoryLitterPickupPerformanceTest::RunTest(const FString& Parameters)
+{
+	using namespace InventoryPerformanceTests;
+
+	FSimulatedMatch Match;
+	constexpr int32 NumLitter = 20000;
+
+	TArray<TObjectPtr<UItemDefinitionDataAsset>> LitterDefinitions(Match.ItemDefinitions);
+	TArray<FLitterPlacement> Placements;
+	Placements.Reserve(NumLitter);
+	for (int32 LitterIndex = 0; LitterIndex < NumLitter; ++LitterIndex)
+	{
+		FLitterPlacement& Placement = Placements.AddDefaulted_GetRef();
+		Placement.DefinitionIndex = LitterIndex % NumItemDefinitions;
+		Placement.Location = FVector3f((LitterIndex % 20) * 10.0f, ((LitterIndex / 20) % 20) * 10.0f, 0.0f);
+		Placement.Yaw = (LitterIndex * 37) % 360;
+	}
+
+	ALitterField* LitterField = Match.World->SpawnActor<ALitterField>();
+	LitterField->InitializeLitter(MoveTemp(LitterDefinitions), MoveTemp(Placements));
+
+	// Prime one bag entry per definition so the measured pickups only grow existing stacks.
+	for (int32 LitterIndex = 0; LitterIndex < NumItemDefinitions * NumSimulatedPlayers; ++LitterIndex)
+	{
+		Match.Inventories[(LitterIndex / NumItemDefinitions) % NumSimulatedPlayers]->RequestPickupLitter(LitterField, LitterIndex);
+	}
+
+	constexpr int32 NumPrimed = NumItemDefinitions * NumSimulatedPlayers;
+	constexpr int64 NumOps = NumLitter - NumPrimed - NumSampledOps;
+	auto Pickup = [&Match, LitterField](int64 OpIndex)
+	{
+		const int32 LitterIndex = NumPrimed + static_cast<int32>(OpIndex);
+		Match.Inventories[OpIndex % NumSimulatedPlayers]->RequestPickupLitter(LitterField, LitterIndex);
+		return LitterIndex;
+	};
+
+	FScenarioResult Result = RunScenario(NumOps, Pickup);
+
+	// The field reference and litter index in, then the changed collected-bits word and the owner's bag delta and
+	// weight out. The collected bits are a plain replicated array, so only the changed element is sent.
+	const FArrayProperty* CollectedBitsProperty = FindFProperty<FArrayProperty>(ALitterField::StaticClass(), TEXT("CollectedLitterBits"));
+	const TArray<uint32>& CollectedBits = *CollectedBitsProperty->ContainerPtrToValuePtr<TArray<uint32>>(LitterField);
+	Result.ReplicatedBytesPerOp = MeasureReplicatedBytesPerOp(Match, NumSampledOps, [&Match, &Pickup, LitterField, &CollectedBits](int64 OpIndex)
+	{
+		const int32 LitterIndex = Pickup(NumOps + OpIndex);
+		return FPayloadMeter(Match)
+			.AddObject(LitterField)
+			.Add(LitterIndex)
+			.Add(CollectedBits[LitterIndex / 32])
+			.GetNumBytes();
+	});
+
+	TestEqual(TEXT("Every litter item was picked up"), LitterField->GetNumRemainingLitter(), 0);
+
+	return ReportAndCheck(*this, TEXT("LitterPickup"), Result);
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FInventoryLitterGenerationPerformanceTest, "CowFieldCleanup.Inventory.Performance.LitterGeneration",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+bool FInventoryLitterGenerationPerformanceTest::RunTest(const FString& Parameters)
+{
+	using namespace InventoryPerformanceTests;
+
+	FSimulatedMatch Match;
+
+	// A 1 km square field at 0.02 items per square meter: roughly 20000 placements per op.
+	FLitterFieldParams Params;
+	Params.Seed = 1337;
+	Params.BoundsMin = FVector2D(-50000.0, -50000.0);
+	Params.BoundsMax = FVector2D(50000.0, 50000.0);
+	Params.Density = 0.02f;
+	for (int32 DefinitionIndex = 0; DefinitionIndex < NumItemDefinitions; ++DefinitionIndex)
+	{
+		FLitterSpawnWeight& ItemWeight = Params.ItemWeights.AddDefaulted_GetRef();
+		ItemWeight.ItemDefinition = Match.ItemDefinitions[DefinitionIndex];
+		ItemWeight.Weight = 1.0f + DefinitionIndex % 4;
+	}
+
+	TArray<FLitterPlacement> ExpectedPlacements;
+	FLitterPlacementGenerator::Generate(Params, ExpectedPlacements);
+
+	TArray<FLitterPlacement> Placements;
+	constexpr int64 NumOps = 200;
+	FScenarioResult Result = RunScenario(NumOps, [&Params, &Placements](int64 OpIndex)
+	{
+		FLitterPlacementGenerator::Generate(Params, Placements);
+	});
+
+	TestTrue(TEXT("Generated field is not empty"), ExpectedPlacements.Num() > 0);
+	TestTrue(TEXT("Generation is bit-identical across runs"), Placements.Num() == ExpectedPlacements.Num()
+		&& FMemory::Memcmp(Placements.GetData(), ExpectedPlacements.GetData(), Placements.Num() * sizeof(FLitterPlacement)) == 0);
+	AddInfo(FString::Printf(TEXT("LitterGeneration: %d placements per field"), ExpectedPlacements.Num()));
+
+	return ReportAndCheck(*this, TEXT("LitterGeneration"), Result);
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FInventoryDroppedToolQueryPerformanceTest, "CowFieldCleanup.Inventory.Performance.DroppedToolQuery",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+bool FInventoryDroppedToolQueryPerformanceTest::RunTest(const FString& Parameters)
+{
+	using namespace InventoryPerformanceTests;
+
+	FSimulatedMatch Match;
+	constexpr int32 NumTools = 1000;
+	for (int32 ToolIndex = 0; ToolIndex < NumTools; ++ToolIndex)
+	{
+		Match.Inventories[ToolIndex % NumSimulatedPlayers]->RegisterOwnDroppedTool(MakeToolId(ToolIndex), MakeToolLocation(ToolIndex, 0));
+	}
+
+	UDroppedToolQuerySubsystem* QuerySubsystem = Match.World->GetSubsystem<UDroppedToolQuerySubsystem>();
+	if (!TestNotNull(TEXT("DroppedToolQuery subsystem"), QuerySubsystem))
+	{
+		return false;
+	}
+
+	// One standing request per simulated cow or farmer, each centered on a different tool.
+	constexpr int32 NumQueriers = 128;
+	TArray<AActor*> Queriers;
+	for (int32 QuerierIndex = 0; QuerierIndex < NumQueriers; ++QuerierIndex)
+	{
+		AActor* Querier = Match.World->SpawnActor<AActor>();
+		QuerySubsystem->RequestNearestTools(Querier, MakeToolLocation(QuerierIndex * 7, 0), 3000.0f, 4);
+		Queriers.Add(Querier);
+	}
+
+	// Evaluate every request each pass so an op is one full batch; the first pass builds the snapshot.
+	IConsoleVariable* BudgetVariable = IConsoleManager::Get().FindConsoleVariable(TEXT("CowFieldCleanup.AI.DroppedToolQueryBudgetMs"));
+	const float PreviousBudgetMs = BudgetVariable->GetFloat();
+	BudgetVariable->Set(1000.0f);
+	QuerySubsystem->Tick(0.0f);
+
+	constexpr int64 NumOps = 2000;
+	const FScenarioResult Result = RunScenario(NumOps, [QuerySubsystem](int64 OpIndex)
+	{
+		QuerySubsystem->Tick(0.0f);
+	});
+
+	BudgetVariable->Set(PreviousBudgetMs);
+
+	const TConstArrayView<FDroppedToolQueryResult> Nearest = QuerySubsystem->GetCachedResults(Queriers[1]);
+	TestTrue(TEXT("DroppedToolQuery finds the tool under the querier first"), !Nearest.IsEmpty() && Nearest[0].ToolId == MakeToolId(7));
+	AddInfo(FString::Printf(TEXT("DroppedToolQuery: %d requests over %d tools per op"), QuerySubsystem->GetNumRequests(), NumTools));
+
+	return ReportAndCheck(*this, TEXT("DroppedToolQuery"), Result);
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FInventoryRejectedBatchWakesOwnerTest, "CowFieldCleanup.Inventory.Replication.RejectedBatchWakesDormantOwner",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FInventoryRejectedBatchWakesOwnerTest::RunTest(const FString& Parameters)
+{
+	using namespace InventoryPerformanceTests;
+
+	FSimulatedMatch Match;
+	FInventoryReplicationLoopback& Loopback = *Match.Loopbacks[0];
+	UInventoryComponent* Inventory = Match.Inventories[0];
+	UInventoryComponent& ClientInventory = Loopback.GetClient();
+	UItemDefinitionDataAsset* FirstDefinition = Match.ItemDefinitions[0];
+	UItemDefinitionDataAsset* SecondDefinition = Match.ItemDefinitions[1];
+	auto GetQuantity = [](const UInventoryComponent& Bag, const UItemDefinitionDataAsset* Definition)
+	{
+		const FBagItemEntry* Entry = Bag.GetBagEntries().FindByPredicate([Definition](const FBagItemEntry& Candidate) { return Candidate.ItemDefinition == Definition; });
+		return Entry ? Entry->Quantity : 0;
+	};
+
+	// A one-token bucket that does not refill within the test, so the second batch is over budget.
+	TStrongObjectPtr<UInventoryBalanceDataAsset> DormantBalanceData(NewObject<UInventoryBalanceDataAsset>(GetTransientPackage()));
+	DormantBalanceData->bOwnerDormantWhileIdle = true;
+	DormantBalanceData->InventoryRpcRateLimit = FInventoryRpcRateLimit(0.001f, 1.0f);
+	DormantBalanceData->RebuildCompiledProfile();
+	Inventory->SetBalanceData(DormantBalanceData.Get());
+
+	// A remote owner, so the rate limiter applies; idle dormancy needs an owner without replicated movement.
+	APawn* OwnerPawn = CastChecked<APawn>(Inventory->GetOwner());
+	OwnerPawn->SetReplicatingMovement(false);
+	APlayerController* Controller = Match.World->SpawnActor<APlayerController>();
+	UDemoNetConnection* Connection = NewObject<UDemoNetConnection>(GetTransientPackage());
+	Controller->Player = Connection;
+	Controller->NetConnection = Connection;
+	OwnerPawn->Controller = Controller;
+
+	ClientInventory.RequestAddBagItem(FirstDefinition, 1);
+	Loopback.SendBatches();
+	Loopback.Replicate();
+	TestEqual(TEXT("The first batch is applied"), GetQuantity(ClientInventory, FirstDefinition), 1);
+
+	// Stands in for the idle dormancy timer firing.
+	OwnerPawn->SetNetDormancy(DORM_DormantAll);
+
+	const UInventoryRpcRateLimitSubsystem* RateLimiter = Match.World->GetSubsystem<UInventoryRpcRateLimitSubsystem>();
+	const uint64 NumRejectedBefore = RateLimiter->GetNumRejected(EInventoryRpcFamily::Inventory);
+	ClientInventory.RequestAddBagItem(SecondDefinition, 1);
+	Loopback.SendBatches();
+	TestEqual(TEXT("The second batch is over budget"), RateLimiter->GetNumRejected(EInventoryRpcFamily::Inventory), NumRejectedBefore + 1);
+	TestEqual(TEXT("The rejected batch is not applied"), GetQuantity(*Inventory, SecondDefinition), 0);
+	TestTrue(TEXT("Acking the rejected batch wakes the owner"), OwnerPawn->NetDormancy == DORM_Awake);
+
+	Loopback.Replicate();
+	TestFalse(TEXT("The client has no prediction left"), Loopback.IsClientPredicting());
+	TestEqual(TEXT("The client rolls back the rejected add"), GetQuantity(ClientInventory, SecondDefinition), 0);
+	TestEqual(TEXT("The client keeps the applied add"), GetQuantity(ClientInventory, FirstDefinition), 1);
+
+	OwnerPawn->Controller = nullptr;
+	Controller->Player = nullptr;
+	Controller->NetConnection = nullptr;
+	return true;
+}
+
+#endif
@@ -0,0 +1,29 @@
+#include "UI/InventoryRowWidget.h"
+
+#include "DataAssets/ItemDefinitionDataAsset.h"
+
+void UInventoryRowWidget::SetToolSlot(int32 InSlotIndex, const FToolSlotEntry& Slot)
+{
+	SlotIndex = InSlotIndex;
+	ItemDefinition = Slot.ItemDefinition;
+	Quantity = Slot.bOccupied ? 1 : 0;
+	NumStacks = Quantity;
+	bOccupied = Slot.bOccupied;
+	MarkRowDirty();
+}
+
+void UInventoryRowWidget::SetBagEntry(const FBagItemEntry& Entry)
+{
+	SlotIndex = INDEX_NONE;
+	ItemDefinition = Entry.ItemDefinition;
+	Quantity = Entry.Quantity;
+	NumStacks = Entry.ItemDefinition ? Entry.ItemDefinition->GetNumStacks(Entry.Quantity) : 0;
+	bOccupied = Entry.Quantity > 0;
+	MarkRowDirty();
+}
+
+void UInventoryRowWidget::MarkRowDirty()
+{
+	OnRowDataChanged();
+	InvalidateLayoutAndVolatility();
+}
@@ -0,0 +1,40 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Blueprint/UserWidget.h"
+#include "Inventory/InventoryTypes.h"
+#include "InventoryRowWidget.generated.h"
+
+class UItemDefinitionDataAsset;
+
+UCLASS()
+class COWFIELDCLEANUP_API UInventoryRowWidget : public UUserWidget
+{
+	GENERATED_BODY()
+
+public:
+	void SetToolSlot(int32 InSlotIndex, const FToolSlotEntry& Slot);
+	void SetBagEntry(const FBagItemEntry& Entry);
+
+	UFUNCTION(BlueprintImplementableEvent, Category = "Inventory")
+	void OnRowDataChanged();
+
+	UPROPERTY(BlueprintReadOnly, Category = "Inventory")
+	TObjectPtr<UItemDefinitionDataAsset> ItemDefinition;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Inventory")
+	int32 SlotIndex = INDEX_NONE;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Inventory")
+	int32 Quantity = 0;
+
+	// Bag stacks the quantity fills at the item's stack size.
+	UPROPERTY(BlueprintReadOnly, Category = "Inventory")
+	int32 NumStacks = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Inventory")
+	bool bOccupied = false;
+
+private:
+	void MarkRowDirty();
+};
@@ -0,0 +1,101 @@
+#include "UI/InventoryViewModel.h"
+
+#include "Inventory/InventoryComponent.h"
+#include "Inventory/InventoryStats.h"
+
+void UInventoryViewModel::Bind(UInventoryComponent* InInventoryComponent)
+{
+	if (InventoryComponent.Get() == InInventoryComponent)
+	{
+		return;
+	}
+
+	Unbind();
+
+	InventoryComponent = InInventoryComponent;
+	if (!InInventoryComponent)
+	{
+		return;
+	}
+
+	LLM_SCOPE_BYTAG(Inventory);
+	InInventoryComponent->OnInventoryChanged.AddDynamic(this, &UInventoryViewModel::HandleInventoryChanged);
+	InInventoryComponent->OnBagEntryChanged.AddDynamic(this, &UInventoryViewModel::HandleBagEntryChanged);
+
+	SyncToolSlots();
+	for (const FBagItemEntry& Entry : InInventoryComponent->GetBagEntries())
+	{
+		OnBagRowChanged.Broadcast(Entry, EInventoryEntryChange::Added);
+	}
+
+	LastBagWeight = InInventoryComponent->GetBagTotalWeight();
+	OnBagWeightChanged.Broadcast(LastBagWeight);
+}
+
+void UInventoryViewModel::Unbind()
+{
+	if (UInventoryComponent* Component = InventoryComponent.Get())
+	{
+		Component->OnInventoryChanged.RemoveDynamic(this, &UInventoryViewModel::HandleInventoryChanged);
+		Component->OnBagEntryChanged.RemoveDynamic(this, &UInventoryViewModel::HandleBagEntryChanged);
+	}
+
+	InventoryComponent.Reset();
+	ToolSlotSnapshots.Reset();
+	LastBagWeight = -1.0f;
+}
+
+UInventoryComponent* UInventoryViewModel::GetInventoryComponent() const
+{
+	return InventoryComponent.Get();
+}
+
+void UInventoryViewModel::HandleInventoryChanged(int32 ChangeMask)
+{
+	const EInventoryChangeFlags Changes = static_cast<EInventoryChangeFlags>(ChangeMask);
+	if (EnumHasAnyFlags(Changes, EInventoryChangeFlags::ToolSlots))
+	{
+		SyncToolSlots();
+	}
+
+	const UInventoryComponent* Component = InventoryComponent.Get();
+	if (Component && EnumHasAnyFlags(Changes, EInventoryChangeFlags::BagWeight) && Component->GetBagTotalWeight() != LastBagWeight)
+	{
+		LastBagWeight = Component->GetBagTotalWeight();
+		OnBagWeightChanged.Broadcast(LastBagWeight);
+	}
+}
+
+void UInventoryViewModel::HandleBagEntryChanged(const FBagItemEntry& Entry, EInventoryEntryChange Change)
+{
+	OnBagRowChanged.Broadcast(Entry, Change);
+}
+
+void UInventoryViewModel::SyncToolSlots()
+{
+	const UInventoryComponent* Component = InventoryComponent.Get();
+	if (!Component)
+	{
+		return;
+	}
+
+	const TArray<FToolSlotEntry>& ToolSlots = Component->GetToolSlots();
+	ToolSlotSnapshots.SetNum(ToolSlots.Num());
+
+	for (int32 SlotIndex = 0; SlotIndex < ToolSlots.Num(); ++SlotIndex)
+	{
+		const FToolSlotEntry& Slot = ToolSlots[SlotIndex];
+		FToolSlotSnapshot& Snapshot = ToolSlotSnapshots[SlotIndex];
+		const TObjectKey<UItemDefinitionDataAsset> ItemKey(Slot.ItemDefinition.Get());
+		if (Snapshot.bValid && Snapshot.ItemDefinition == ItemKey && Snapshot.ToolId == Slot.ToolId && Snapshot.bOccupied == Slot.bOccupied)
+		{
+			continue;
+		}
+
+		Snapshot.bValid = true;
+		Snapshot.ItemDefinition = ItemKey;
+		Snapshot.ToolId = Slot.ToolId;
+		Snapshot.bOccupied = Slot.bOccupied;
+		OnToolSlotRowChanged.Broadcast(SlotIndex, Slot);
+	}
+}
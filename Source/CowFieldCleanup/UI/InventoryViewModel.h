@@ -0,0 +1,52 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Inventory/InventoryTypes.h"
+#include "UObject/Object.h"
+#include "UObject/ObjectKey.h"
+#include "InventoryViewModel.generated.h"
+
+class UInventoryComponent;
+
+DECLARE_MULTICAST_DELEGATE_TwoParams(FOnToolSlotRowChanged, int32 /*SlotIndex*/, const FToolSlotEntry& /*Slot*/);
+DECLARE_MULTICAST_DELEGATE_TwoParams(FOnBagRowChanged, const FBagItemEntry& /*Entry*/, EInventoryEntryChange /*Change*/);
+DECLARE_MULTICAST_DELEGATE_OneParam(FOnBagWeightRowChanged, float /*NewWeight*/);
+
+UCLASS()
+class COWFIELDCLEANUP_API UInventoryViewModel : public UObject
+{
+	GENERATED_BODY()
+
+public:
+	void Bind(UInventoryComponent* InInventoryComponent);
+	void Unbind();
+
+	UInventoryComponent* GetInventoryComponent() const;
+
+	FOnToolSlotRowChanged OnToolSlotRowChanged;
+	FOnBagRowChanged OnBagRowChanged;
+	FOnBagWeightRowChanged OnBagWeightChanged;
+
+private:
+	UFUNCTION()
+	void HandleInventoryChanged(int32 ChangeMask);
+
+	UFUNCTION()
+	void HandleBagEntryChanged(const FBagItemEntry& Entry, EInventoryEntryChange Change);
+
+	void SyncToolSlots();
+
+	UPROPERTY()
+	TWeakObjectPtr<UInventoryComponent> InventoryComponent;
+
+	struct FToolSlotSnapshot
+	{
+		TObjectKey<UItemDefinitionDataAsset> ItemDefinition;
+		FGuid ToolId;
+		bool bOccupied = false;
+		bool bValid = false;
+	};
+
+	TArray<FToolSlotSnapshot, TInlineAllocator<8>> ToolSlotSnapshots;
+	float LastBagWeight = -1.0f;
+};
@@ -1,6 +1,32 @@
 #include "UI/InventoryWidget.h"
 
+#include "Components/PanelWidget.h"
 #include "Inventory/InventoryComponent.h"
+#include "Inventory/InventoryStats.h"
+#include "UI/InventoryRowWidget.h"
+#include "UI/InventoryViewModel.h"
+
+void UInventoryWidget::BindToInventory(UInventoryComponent* InventoryComponent)
+{
+	LLM_SCOPE_BYTAG(Inventory);
+
+	if (!ViewModel)
+	{
+		ViewModel = NewObject<UInventoryViewModel>(this);
+		ViewModel->OnToolSlotRowChanged.AddUObject(this, &UInventoryWidget::HandleToolSlotRowChanged);
+		ViewModel->OnBagRowChanged.AddUObject(this, &UInventoryWidget::HandleBagRowChanged);
+		ViewModel->OnBagWeightChanged.AddUObject(this, &UInventoryWidget::HandleBagWeightChanged);
+	}
+
+	if (ViewModel->GetInventoryComponent() == InventoryComponent)
+	{
+		return;
+	}
+
+	ViewModel->Unbind();
+	ClearRows();
+	ViewModel->Bind(InventoryComponent);
+}
 
 void UInventoryWidget::UpdateFromInventory(UInventoryComponent* InventoryComponent)
 {
@@ -9,7 +35,102 @@ void UInventoryWidget::UpdateFromInventory(UInventoryComponent* InventoryCompone
 		return;
 	}
 
-	ToolSlots = InventoryComponent->GetToolSlots();
-	BagEntries = InventoryComponent->GetBagEntries();
-	BagWeight = InventoryComponent->GetBagTotalWeight();
+	BindToInventory(InventoryComponent);
+}
+
+void UInventoryWidget::NativeDestruct()
+{
+	if (ViewModel)
+	{
+		ViewModel->Unbind();
+	}
+
+	Super::NativeDestruct();
+}
+
+void UInventoryWidget::HandleToolSlotRowChanged(int32 SlotIndex, const FToolSlotEntry& Slot)
+{
+	if (!ToolSlotRowClass)
+	{
+		return;
+	}
+
+	LLM_SCOPE_BYTAG(Inventory);
+	while (ToolSlotRows.Num() <= SlotIndex)
+	{
+		UInventoryRowWidget* Row = CreateWidget<UInventoryRowWidget>(this, ToolSlotRowClass);
+		ToolSlotRows.Add(Row);
+		if (ToolSlotPanel)
+		{
+			ToolSlotPanel->AddChild(Row);
+		}
+	}
+
+	ToolSlotRows[SlotIndex]->SetToolSlot(SlotIndex, Slot);
+}
+
+void UInventoryWidget::HandleBagRowChanged(const FBagItemEntry& Entry, EInventoryEntryChange Change)
+{
+	if (!BagRowClass || !Entry.ItemDefinition)
+	{
+		return;
+	}
+
+	if (Change == EInventoryEntryChange::Removed)
+	{
+		TObjectPtr<UInventoryRowWidget> Row;
+		if (BagRows.RemoveAndCopyValue(Entry.ItemDefinition, Row) && Row)
+		{
+			Row->RemoveFromParent();
+			FreeBagRows.Add(Row);
+		}
+		return;
+	}
+
+	TObjectPtr<UInventoryRowWidget>& Row = BagRows.FindOrAdd(Entry.ItemDefinition);
+	if (!Row)
+	{
+		Row = AcquireBagRow();
+	}
+
+	Row->SetBagEntry(Entry);
+}
+
+void UInventoryWidget::HandleBagWeightChanged(float NewWeight)
+{
+	BagWeight = NewWeight;
+	OnBagWeightUpdated(NewWeight);
+}
+
+UInventoryRowWidget* UInventoryWidget::AcquireBagRow()
+{
+	LLM_SCOPE_BYTAG(Inventory);
+	UInventoryRowWidget* Row = FreeBagRows.IsEmpty() ? CreateWidget<UInventoryRowWidget>(this, BagRowClass) : FreeBagRows.Pop(EAllowShrinking::No).Get();
+	if (BagPanel)
+	{
+		BagPanel->AddChild(Row);
+	}
+	return Row;
+}
+
+void UInventoryWidget::ClearRows()
+{
+	for (const TPair<TObjectPtr<UItemDefinitionDataAsset>, TObjectPtr<UInventoryRowWidget>>& BagRow : BagRows)
+	{
+		if (BagRow.Value)
+		{
+			BagRow.Value->RemoveFromParent();
+			FreeBagRows.Add(BagRow.Value);
+		}
+	}
+	BagRows.Reset();
+
+	for (UInventoryRowWidget* Row : ToolSlotRows)
+	{
+		if (Row)
+		{
+			Row->RemoveFromParent();
+		}
+	}
+	ToolSlotRows.Reset();
 }
@@ -6,6 +6,10 @@
 #include "InventoryWidget.generated.h"
 
 class UInventoryComponent;
+class UInventoryRowWidget;
+class UInventoryViewModel;
+class UItemDefinitionDataAsset;
+class UPanelWidget;
 
 UCLASS()
 class COWFIELDCLEANUP_API UInventoryWidget : public UUserWidget
@@ -14,14 +18,48 @@ class COWFIELDCLEANUP_API UInventoryWidget : public UUserWidget
 
 public:
 	UFUNCTION(BlueprintCallable, Category = "Inventory")
-	void UpdateFromInventory(UInventoryComponent* InventoryComponent);
+	void BindToInventory(UInventoryComponent* InventoryComponent);
 
-	UPROPERTY(BlueprintReadOnly, Category = "Inventory")
-	TArray<FToolSlotEntry> ToolSlots;
+	UFUNCTION(BlueprintCallable, Category = "Inventory")
+	void UpdateFromInventory(UInventoryComponent* InventoryComponent);
 
-	UPROPERTY(BlueprintReadOnly, Category = "Inventory")
-	TArray<FBagItemEntry> BagEntries;
+	UFUNCTION(BlueprintImplementableEvent, Category = "Inventory")
+	void OnBagWeightUpdated(float NewWeight);
 
 	UPROPERTY(BlueprintReadOnly, Category = "Inventory")
 	float BagWeight = 0.0f;
+
+protected:
+	virtual void NativeDestruct() override;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Inventory", meta = (BindWidgetOptional))
+	TObjectPtr<UPanelWidget> ToolSlotPanel;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Inventory", meta = (BindWidgetOptional))
+	TObjectPtr<UPanelWidget> BagPanel;
+
+	UPROPERTY(EditDefaultsOnly, Category = "Inventory")
+	TSubclassOf<UInventoryRowWidget> ToolSlotRowClass;
+
+	UPROPERTY(EditDefaultsOnly, Category = "Inventory")
+	TSubclassOf<UInventoryRowWidget> BagRowClass;
+
+private:
+	void HandleToolSlotRowChanged(int32 SlotIndex, const FToolSlotEntry& Slot);
+	void HandleBagRowChanged(const FBagItemEntry& Entry, EInventoryEntryChange Change);
+	void HandleBagWeightChanged(float NewWeight);
+	UInventoryRowWidget* AcquireBagRow();
+	void ClearRows();
+
+	UPROPERTY(Transient)
+	TObjectPtr<UInventoryViewModel> ViewModel;
+
+	UPROPERTY(Transient)
+	TArray<TObjectPtr<UInventoryRowWidget>> ToolSlotRows;
+
+	UPROPERTY(Transient)
+	TMap<TObjectPtr<UItemDefinitionDataAsset>, TObjectPtr<UInventoryRowWidget>> BagRows;
+
+	UPROPERTY(Transient)
+	TArray<TObjectPtr<UInventoryRowWidget>> FreeBagRows;
 };
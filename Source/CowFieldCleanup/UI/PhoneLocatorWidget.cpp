@@ -1,7 +1,106 @@
 #include "UI/PhoneLocatorWidget.h"
 
+#include "Inventory/InventoryComponent.h"
+
 void UPhoneLocatorWidget::ShowLocatorResult(ELocatorDistanceBand DistanceBand, float Distance)
 {
 	CurrentDistanceBand = DistanceBand;
 	CurrentDistance = Distance;
 }
+
+void UPhoneLocatorWidget::ShowLocatorResults(const TArray<FToolLocatorResult>& Results)
+{
+	CurrentResults = Results;
+	OnLocatorResultsUpdated();
+}
+
+void UPhoneLocatorWidget::LocateAllTools(UInventoryComponent* InventoryComponent, int32 MaxResults)
+{
+	if (!InventoryComponent)
+	{
+		return;
+	}
+
+	if (LocateAllComponent.Get() != InventoryComponent)
+	{
+		UnbindLocateAll();
+		LocateAllComponent = InventoryComponent;
+		InventoryComponent->OnToolLocatorResults.AddDynamic(this, &UPhoneLocatorWidget::HandleToolLocatorResults);
+	}
+
+	InventoryComponent->RequestLocateAllMyTools(MaxResults);
+}
+
+void UPhoneLocatorWidget::StartTracking(UInventoryComponent* InventoryComponent, const FGuid& ToolId)
+{
+	StopTracking();
+
+	if (!InventoryComponent || !ToolId.IsValid())
+	{
+		return;
+	}
+
+	TrackingComponent = InventoryComponent;
+	TrackedToolId = ToolId;
+	bIsTracking = true;
+
+	InventoryComponent->OnLocatorTrackingUpdate.AddDynamic(this, &UPhoneLocatorWidget::HandleLocatorTrackingUpdate);
+	InventoryComponent->StartLocatorTracking(ToolId);
+}
+
+void UPhoneLocatorWidget::StopTracking()
+{
+	if (UInventoryComponent* InventoryComponent = TrackingComponent.Get())
+	{
+		InventoryComponent->OnLocatorTrackingUpdate.RemoveDynamic(this, &UPhoneLocatorWidget::HandleLocatorTrackingUpdate);
+		if (bIsTracking)
+		{
+			InventoryComponent->StopLocatorTracking();
+		}
+	}
+
+	TrackingComponent.Reset();
+	TrackedToolId.Invalidate();
+	bIsTracking = false;
+}
+
+void UPhoneLocatorWidget::NativeDestruct()
+{
+	StopTracking();
+	UnbindLocateAll();
+
+	Super::NativeDestruct();
+}
+
+void UPhoneLocatorWidget::HandleLocatorTrackingUpdate(const FGuid& ToolId, ELocatorDistanceBand DistanceBand, float DirectionYaw, float Distance)
+{
+	if (ToolId != TrackedToolId)
+	{
+		return;
+	}
+
+	ShowLocatorResult(DistanceBand, Distance);
+	CurrentDirectionYaw = DirectionYaw;
+
+	if (DistanceBand == ELocatorDistanceBand::Unknown)
+	{
+		bIsTracking = false;
+	}
+
+	OnTrackingUpdated();
+}
+
+void UPhoneLocatorWidget::HandleToolLocatorResults(const TArray<FToolLocatorResult>& Results)
+{
+	ShowLocatorResults(Results);
+}
+
+void UPhoneLocatorWidget::UnbindLocateAll()
+{
+	if (UInventoryComponent* InventoryComponent = LocateAllComponent.Get())
+	{
+		InventoryComponent->OnToolLocatorResults.RemoveDynamic(this, &UPhoneLocatorWidget::HandleToolLocatorResults);
+	}
+
+	LocateAllComponent.Reset();
+}
@@ -5,6 +5,8 @@
 #include "Inventory/InventoryTypes.h"
 #include "PhoneLocatorWidget.generated.h"
 
+class UInventoryComponent;
+
 UCLASS()
 class COWFIELDCLEANUP_API UPhoneLocatorWidget : public UUserWidget
 {
@@ -14,9 +16,54 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Locator")
 	void ShowLocatorResult(ELocatorDistanceBand DistanceBand, float Distance);
 
+	UFUNCTION(BlueprintCallable, Category = "Locator")
+	void ShowLocatorResults(const TArray<FToolLocatorResult>& Results);
+
+	// Pings every dropped tool the player owns; results arrive through OnLocatorResultsUpdated.
+	UFUNCTION(BlueprintCallable, Category = "Locator")
+	void LocateAllTools(UInventoryComponent* InventoryComponent, int32 MaxResults);
+
+	UFUNCTION(BlueprintCallable, Category = "Locator")
+	void StartTracking(UInventoryComponent* InventoryComponent, const FGuid& ToolId);
+
+	UFUNCTION(BlueprintCallable, Category = "Locator")
+	void StopTracking();
+
+	UFUNCTION(BlueprintImplementableEvent, Category = "Locator")
+	void OnTrackingUpdated();
+
+	UFUNCTION(BlueprintImplementableEvent, Category = "Locator")
+	void OnLocatorResultsUpdated();
+
 	UPROPERTY(BlueprintReadOnly, Category = "Locator")
 	ELocatorDistanceBand CurrentDistanceBand = ELocatorDistanceBand::Unknown;
 
 	UPROPERTY(BlueprintReadOnly, Category = "Locator")
 	float CurrentDistance = 0.0f;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Locator")
+	float CurrentDirectionYaw = 0.0f;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Locator")
+	bool bIsTracking = false;
+
+	// Nearest first.
+	UPROPERTY(BlueprintReadOnly, Category = "Locator")
+	TArray<FToolLocatorResult> CurrentResults;
+
+protected:
+	virtual void NativeDestruct() override;
+
+private:
+	UFUNCTION()
+	void HandleLocatorTrackingUpdate(const FGuid& ToolId, ELocatorDistanceBand DistanceBand, float DirectionYaw, float Distance);
+
+	UFUNCTION()
+	void HandleToolLocatorResults(const TArray<FToolLocatorResult>& Results);
+
+	void UnbindLocateAll();
+
+	TWeakObjectPtr<UInventoryComponent> TrackingComponent;
+	TWeakObjectPtr<UInventoryComponent> LocateAllComponent;
+	FGuid TrackedToolId;
 };
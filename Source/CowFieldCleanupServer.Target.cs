@@ -0,0 +1,12 @@
+using UnrealBuildTool;
+
+public class CowFieldCleanupServerTarget : TargetRules
+{
+	public CowFieldCleanupServerTarget(TargetInfo Target) : base(Target)
+	{
+		Type = TargetType.Server;
+		DefaultBuildSettings = BuildSettingsVersion.Latest;
+		IncludeOrderVersion = EngineIncludeOrderVersion.Latest;
+		ExtraModuleNames.Add("CowFieldCleanup");
+	}
+}